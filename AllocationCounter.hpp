@@ -0,0 +1,98 @@
+// AllocationCounter.hpp
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+// --- 堆分配计数 (测试/基准用) ---
+// 用于验证稳态 update() 不做堆分配。计数按线程进行, 只统计调用线程上的 operator new。
+// 在且仅在一个翻译单元中先定义 JSBSIM_COUNT_ALLOCATIONS 再包含本文件, 该单元即替换全局
+// operator new/delete 并开始计数; 其余单元照常包含, 未替换时 installed() 为 false, 计数恒为0。
+//
+//   #define JSBSIM_COUNT_ALLOCATIONS
+//   #include "AllocationCounter.hpp"
+//   ...
+//   AllocationScope scope;
+//   aircraft.update(dt);
+//   if (scope.allocations() != 0) ...
+namespace alloc_counter {
+
+inline std::atomic<bool> g_installed{false};
+inline thread_local std::uint64_t t_allocations = 0;
+inline thread_local std::uint64_t t_bytes = 0;
+
+inline bool installed() { return g_installed.load(std::memory_order_relaxed); }
+inline std::uint64_t allocations() { return t_allocations; }
+inline std::uint64_t bytes() { return t_bytes; }
+
+} // namespace alloc_counter
+
+// 作用域内当前线程的分配次数与字节数
+class AllocationScope {
+public:
+    AllocationScope() : m_allocations(alloc_counter::allocations()), m_bytes(alloc_counter::bytes()) {}
+
+    std::uint64_t allocations() const { return alloc_counter::allocations() - m_allocations; }
+    std::uint64_t bytes() const { return alloc_counter::bytes() - m_bytes; }
+
+private:
+    std::uint64_t m_allocations;
+    std::uint64_t m_bytes;
+};
+
+#ifdef JSBSIM_COUNT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+namespace alloc_counter {
+namespace detail {
+
+inline void* allocate(std::size_t size) {
+    ++t_allocations;
+    t_bytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+inline void* allocateAligned(std::size_t size, std::align_val_t align) {
+    ++t_allocations;
+    t_bytes += size;
+    const std::size_t a = static_cast<std::size_t>(align);
+    // aligned_alloc 要求长度为对齐值的整数倍
+    if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a)) return p;
+    throw std::bad_alloc();
+}
+
+struct Installer {
+    Installer() { g_installed.store(true, std::memory_order_relaxed); }
+};
+static Installer s_installer;
+
+} // namespace detail
+} // namespace alloc_counter
+
+void* operator new(std::size_t size) { return alloc_counter::detail::allocate(size); }
+void* operator new[](std::size_t size) { return alloc_counter::detail::allocate(size); }
+void* operator new(std::size_t size, std::align_val_t align) { return alloc_counter::detail::allocateAligned(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return alloc_counter::detail::allocateAligned(size, align); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return alloc_counter::detail::allocate(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return alloc_counter::detail::allocate(size); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+#endif // JSBSIM_COUNT_ALLOCATIONS
+
+#endif // ALLOCATION_COUNTER_HPP
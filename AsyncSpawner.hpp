@@ -0,0 +1,223 @@
+// AsyncSpawner.hpp
+#ifndef ASYNC_SPAWNER_HPP
+#define ASYNC_SPAWNER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "FleetExecutor.hpp"
+#include "ModelTemplateCache.hpp"
+
+// --- 出生请求 ---
+struct SpawnRequest {
+    std::string jsbsim_root_dir;
+    std::string aircraft_model;
+
+    // setInitialConditions 参数
+    double lat_deg = 0.0, lon_deg = 0.0, alt_m = 0.0, hdg_deg = 0.0, speed_kts = 0.0;
+
+    // 空中出生时配平: configure 设置了配平缓存时按缓存查找, 否则完整配平(setTrimOnInit)
+    bool trim = true;
+};
+
+// --- 后台异步加载飞机 ---
+// 场景进行中出生新飞机时, init() 的读盘与XML解析以及 runInitialConditions() 的配平
+// 在加载线程池上完成, 仿真线程只在帧边界调用 collectReady() 把已就绪的实例交给机群,
+// 因此出生不会拖慢其他飞机的帧。
+//
+// Model 为 StandaloneJSBSimModel 或 V2 的 StandaloneJSBSim: 加载线程上以 setVerbose(false) 关闭
+// 加载信息输出, 设置了模型缓存时先 setModelCache()。JSBSim 的调试级别是进程全局的, 由构造函数在
+// 主线程上、加载线程启动前设置一次, 加载线程不再修改。configure 回调在 init() 之前于加载线程上调用,
+// 可设置配平缓存、遥测声明等; init() 之后的控制输入应在 collectReady() 交付后于仿真线程上设置。
+//
+// spawn() 返回的 future 在交付时就绪, 值为机群中的实例; 加载或配平失败时为 nullptr。
+// prefetch() 提示即将出生的机型, 在空闲的加载线程上预加载到模型缓存, 使之后的 spawn() 只需复位。
+// spawn()/prefetch() 可从任意线程调用; collectReady() 须与 stepAll() 在同一线程、帧与帧之间调用。
+template<class Model>
+class AsyncSpawner {
+public:
+    using Configure = std::function<void(Model&)>;
+
+    // jsbsim_debug_level < 0 时保留当前的调试级别
+    explicit AsyncSpawner(unsigned loader_threads = 1, ModelTemplateCache* cache = nullptr, int jsbsim_debug_level = 0)
+        : m_cache(cache)
+    {
+        if (jsbsim_debug_level >= 0) ModelTemplateCache::setJSBSimDebugLevel(jsbsim_debug_level);
+        if (loader_threads == 0) loader_threads = 1;
+        for (unsigned t = 0; t < loader_threads; ++t) {
+            m_threads.emplace_back([this] { loaderLoop(); });
+        }
+    }
+
+    // 未开始的请求直接以失败结束; 正在加载的请求等待其完成后丢弃
+    ~AsyncSpawner() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_shutdown = true;
+        }
+        m_cv.notify_all();
+        for (auto& t : m_threads) t.join();
+        for (auto& job : m_spawns) job.promise.set_value(nullptr);
+        for (auto& job : m_ready) job.promise.set_value(nullptr);
+    }
+
+    AsyncSpawner(const AsyncSpawner&) = delete;
+    AsyncSpawner& operator=(const AsyncSpawner&) = delete;
+
+    // --- 出生与预加载 ---
+    std::shared_future<Model*> spawn(const SpawnRequest& request, Configure configure = Configure()) {
+        SpawnJob job;
+        job.request = request;
+        job.configure = std::move(configure);
+        std::shared_future<Model*> result = job.promise.get_future().share();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_spawns.push_back(std::move(job));
+        }
+        m_cv.notify_one();
+        return result;
+    }
+
+    // 预加载 count 个该机型的执行器到模型缓存, 出生请求优先于预加载执行; 未设置模型缓存时返回 false
+    bool prefetch(const std::string& jsbsim_root_dir, const std::string& aircraft_model, std::size_t count = 1) {
+        if (!m_cache || count == 0) return false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (std::size_t i = 0; i < count; ++i) m_prefetches.push_back({jsbsim_root_dir, aircraft_model});
+        }
+        m_cv.notify_all();
+        return true;
+    }
+
+    // --- 帧边界交付 ---
+    // 把最多 max_count 个已就绪的实例加入机群并兑现其 future, 返回加入的数量
+    std::size_t collectReady(FleetExecutor<Model>& fleet, std::size_t max_count = static_cast<std::size_t>(-1)) {
+        std::vector<ReadyJob> ready;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            while (!m_ready.empty() && ready.size() < max_count) {
+                ready.push_back(std::move(m_ready.front()));
+                m_ready.pop_front();
+            }
+        }
+        for (auto& job : ready) {
+            Model& model = fleet.add(std::move(job.model));
+            job.promise.set_value(&model);
+        }
+        return ready.size();
+    }
+
+    // --- 获取状态 ---
+    // 尚未交付的出生请求数(排队、加载中与已就绪)
+    std::size_t pending() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_spawns.size() + m_loading + m_ready.size();
+    }
+    std::size_t readyCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_ready.size();
+    }
+    std::size_t pendingPrefetches() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_prefetches.size();
+    }
+
+private:
+    struct SpawnJob {
+        SpawnRequest request;
+        Configure configure;
+        std::promise<Model*> promise;
+    };
+
+    struct ReadyJob {
+        std::unique_ptr<Model> model;
+        std::promise<Model*> promise;
+    };
+
+    struct PrefetchJob {
+        std::string jsbsim_root_dir;
+        std::string aircraft_model;
+    };
+
+    void loaderLoop() {
+        for (;;) {
+            SpawnJob spawn;
+            PrefetchJob prefetch;
+            bool is_spawn = false;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this] { return m_shutdown || !m_spawns.empty() || !m_prefetches.empty(); });
+                if (m_shutdown) return;
+                if (!m_spawns.empty()) {
+                    spawn = std::move(m_spawns.front());
+                    m_spawns.pop_front();
+                    ++m_loading;
+                    is_spawn = true;
+                } else {
+                    prefetch = std::move(m_prefetches.front());
+                    m_prefetches.pop_front();
+                }
+            }
+
+            if (!is_spawn) {
+                ModelLoadOptions options = Model::cacheLoadOptions();
+                options.debug_level = -1; // 调试级别已在构造时设置
+                m_cache->prewarm(prefetch.jsbsim_root_dir, prefetch.aircraft_model, 1, options);
+                continue;
+            }
+
+            std::unique_ptr<Model> model = load(spawn);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_loading;
+            if (model) {
+                m_ready.push_back({std::move(model), std::move(spawn.promise)});
+            } else {
+                spawn.promise.set_value(nullptr);
+            }
+        }
+    }
+
+    // 在加载线程上完成 init() + 初始条件 + 配平
+    std::unique_ptr<Model> load(SpawnJob& job) {
+        const SpawnRequest& r = job.request;
+        try {
+            auto model = std::make_unique<Model>();
+            model->setVerbose(false);
+            if (m_cache) model->setModelCache(m_cache);
+            if (job.configure) job.configure(*model);
+            if (!model->init(r.jsbsim_root_dir, r.aircraft_model)) return nullptr;
+            model->setInitialConditions(r.lat_deg, r.lon_deg, r.alt_m, r.hdg_deg, r.speed_kts);
+            model->setTrimOnInit(r.trim);
+            if (!model->runInitialConditions()) return nullptr;
+            return model;
+        } catch (const std::exception& e) {
+            std::cerr << "Async spawn of " << r.aircraft_model << " failed: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "Async spawn of " << r.aircraft_model << " failed" << std::endl;
+        }
+        return nullptr;
+    }
+
+    ModelTemplateCache* m_cache = nullptr;
+    std::vector<std::thread> m_threads;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<SpawnJob> m_spawns;
+    std::deque<PrefetchJob> m_prefetches;
+    std::deque<ReadyJob> m_ready;
+    std::size_t m_loading = 0;
+    bool m_shutdown = false;
+};
+
+#endif // ASYNC_SPAWNER_HPP
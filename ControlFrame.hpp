@@ -0,0 +1,141 @@
+// ControlFrame.hpp
+#ifndef CONTROL_FRAME_HPP
+#define CONTROL_FRAME_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+// --- 一帧控制输入 ---
+// 只有 valid 中置位的字段才会被 applyControls() 写入FCS, 其余保持原值。
+// 数值约定与各 set* 接口一致(杆量 -1~1, 油门 0~1, 配平/减速板开关 -1/0/1)。
+struct ControlFrame {
+    enum Field : std::uint32_t {
+        Roll        = 1u << 0,
+        Pitch       = 1u << 1,
+        Rudder      = 1u << 2,
+        ThrottleAll = 1u << 3, // 所有发动机同一油门
+        Throttle    = 1u << 4, // 按 throttle_engines 掩码逐台设置, 在 ThrottleAll 之后生效
+        Gear        = 1u << 5,
+        Brakes      = 1u << 6,
+        SpeedBrake  = 1u << 7,
+        TrimRoll    = 1u << 8,
+        TrimPitch   = 1u << 9
+    };
+
+    static const int MAX_ENGINES = 8;
+
+    std::uint32_t valid = 0;
+    double roll = 0.0;
+    double pitch = 0.0;
+    double rudder = 0.0;
+    double throttle_all = 0.0;
+    std::uint32_t throttle_engines = 0;
+    double throttle[MAX_ENGINES] = {};
+    bool gear_down = true;
+    double brake_left = 0.0;
+    double brake_right = 0.0;
+    double speed_brake = 0.0;
+    double trim_roll = 0.0;
+    double trim_pitch = 0.0;
+
+    ControlFrame& setRoll(double v) { roll = v; valid |= Roll; return *this; }
+    ControlFrame& setPitch(double v) { pitch = v; valid |= Pitch; return *this; }
+    ControlFrame& setRudder(double v) { rudder = v; valid |= Rudder; return *this; }
+    ControlFrame& setThrottles(double v) { throttle_all = v; valid |= ThrottleAll; return *this; }
+    ControlFrame& setThrottle(int engine_idx, double v) {
+        if (engine_idx < 0 || engine_idx >= MAX_ENGINES) return *this;
+        throttle[engine_idx] = v;
+        throttle_engines |= 1u << engine_idx;
+        valid |= Throttle;
+        return *this;
+    }
+    ControlFrame& setGearHandle(bool down) { gear_down = down; valid |= Gear; return *this; }
+    ControlFrame& setBrakes(double left, double right) { brake_left = left; brake_right = right; valid |= Brakes; return *this; }
+    ControlFrame& setSpeedBrakes(double v) { speed_brake = v; valid |= SpeedBrake; return *this; }
+    ControlFrame& setTrimSwitchRoll(double v) { trim_roll = v; valid |= TrimRoll; return *this; }
+    ControlFrame& setTrimSwitchPitch(double v) { trim_pitch = v; valid |= TrimPitch; return *this; }
+
+    // 用 other 中有效的字段覆盖本帧, 用于合并同一时刻到期的多条指令
+    void merge(const ControlFrame& other) {
+        const std::uint32_t v = other.valid;
+        if (v & Roll) roll = other.roll;
+        if (v & Pitch) pitch = other.pitch;
+        if (v & Rudder) rudder = other.rudder;
+        if (v & ThrottleAll) {
+            throttle_all = other.throttle_all;
+            throttle_engines = 0; // 之前的逐台设置被整体油门覆盖
+            valid &= ~static_cast<std::uint32_t>(Throttle);
+        }
+        if (v & Throttle) {
+            for (int i = 0; i < MAX_ENGINES; ++i) {
+                if (other.throttle_engines & (1u << i)) throttle[i] = other.throttle[i];
+            }
+            throttle_engines |= other.throttle_engines;
+        }
+        if (v & Gear) gear_down = other.gear_down;
+        if (v & Brakes) { brake_left = other.brake_left; brake_right = other.brake_right; }
+        if (v & SpeedBrake) speed_brake = other.speed_brake;
+        if (v & TrimRoll) trim_roll = other.trim_roll;
+        if (v & TrimPitch) trim_pitch = other.trim_pitch;
+        valid |= v;
+    }
+};
+
+// --- 带时间戳的控制指令队列 ---
+// 网络/AI线程随时 push(仿真时间, 指令); 模型在每个积分步(多速率模式下为每个子步)开始前
+// 取出离该步起点最近的到期指令合并后应用, 指令不会丢失, 最多相差半个步长。
+// 时间戳以模型的仿真时间(秒)为基准。
+class ControlCommandQueue {
+public:
+    void push(double sim_time, const ControlFrame& frame) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Entry entry{sim_time, frame};
+        // 按时间排序, 同一时刻保持提交顺序
+        auto it = std::upper_bound(m_entries.begin(), m_entries.end(), sim_time,
+                                   [](double t, const Entry& e) { return t < e.time; });
+        m_entries.insert(it, entry);
+        m_nextDue.store(m_entries.front().time, std::memory_order_release);
+    }
+
+    // 取出所有时间戳早于 before 的指令, 按时间顺序合并到 out; 没有到期指令时不加锁
+    bool popDue(double before, ControlFrame& out) {
+        if (m_nextDue.load(std::memory_order_acquire) >= before) return false;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::size_t n = 0;
+        while (n < m_entries.size() && m_entries[n].time < before) {
+            out.merge(m_entries[n].frame);
+            ++n;
+        }
+        m_entries.erase(m_entries.begin(), m_entries.begin() + static_cast<std::ptrdiff_t>(n));
+        m_nextDue.store(m_entries.empty() ? std::numeric_limits<double>::infinity() : m_entries.front().time,
+                        std::memory_order_release);
+        return n > 0;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+        m_nextDue.store(std::numeric_limits<double>::infinity(), std::memory_order_release);
+    }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_entries.size();
+    }
+
+private:
+    struct Entry {
+        double time;
+        ControlFrame frame;
+    };
+
+    mutable std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+    std::atomic<double> m_nextDue{std::numeric_limits<double>::infinity()};
+};
+
+#endif // CONTROL_FRAME_HPP
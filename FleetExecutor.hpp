@@ -0,0 +1,238 @@
+// FleetExecutor.hpp
+#ifndef FLEET_EXECUTOR_HPP
+#define FLEET_EXECUTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// --- 单帧执行统计 ---
+struct FleetFrameStats {
+    double wall_time_ms = 0.0;              // stepAll() 的墙钟耗时
+    std::vector<double> worker_busy_ms;     // 每个工作线程本帧的忙碌时间
+    std::vector<std::size_t> worker_steps;  // 每个工作线程本帧推进的飞机数
+    std::vector<std::size_t> worker_steals; // 其中从其他线程窃取的数量
+
+    // 并行效率: 总忙碌时间 / (线程数 * 墙钟时间), 1.0 表示完全均衡
+    double efficiency() const {
+        if (wall_time_ms <= 0.0 || worker_busy_ms.empty()) return 0.0;
+        double busy = 0.0;
+        for (double b : worker_busy_ms) busy += b;
+        return busy / (wall_time_ms * static_cast<double>(worker_busy_ms.size()));
+    }
+};
+
+// --- 机群并行执行器 ---
+// 持有N个模型实例(StandaloneJSBSimModel 或 V2 的 StandaloneJSBSim),
+// 一次 stepAll(dt) 推进所有飞机一帧。
+// 每架飞机按连续区间固定归属一个工作线程, 每帧都由同一线程推进以保持缓存局部性;
+// 某线程的区间先跑完后, 会从其他线程的区间中窃取剩余飞机, 吸收单机耗时不均。
+// 调用线程本身充当0号工作线程。add()/emplace() 只能在 stepAll() 之外调用。
+template<class Model>
+class FleetExecutor {
+public:
+    explicit FleetExecutor(unsigned num_workers = 0, bool pin_threads = false)
+    {
+        if (num_workers == 0) num_workers = std::max(1u, std::thread::hardware_concurrency());
+        m_workers = std::vector<Worker>(num_workers);
+        m_stats.worker_busy_ms.assign(num_workers, 0.0);
+        m_stats.worker_steps.assign(num_workers, 0);
+        m_stats.worker_steals.assign(num_workers, 0);
+
+        for (unsigned w = 1; w < num_workers; ++w) {
+            m_threads.emplace_back([this, w] { workerLoop(w); });
+        }
+        if (pin_threads) {
+            for (unsigned w = 1; w < num_workers; ++w) pinThread(m_threads[w - 1], w);
+        }
+    }
+
+    ~FleetExecutor() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_shutdown = true;
+            ++m_generation;
+        }
+        m_startCv.notify_all();
+        for (auto& t : m_threads) t.join();
+    }
+
+    FleetExecutor(const FleetExecutor&) = delete;
+    FleetExecutor& operator=(const FleetExecutor&) = delete;
+
+    // --- 机群管理 ---
+    Model& add(std::unique_ptr<Model> model) {
+        m_models.push_back(std::move(model));
+        repartition();
+        return *m_models.back();
+    }
+
+    template<class... Args>
+    Model& emplace(Args&&... args) {
+        return add(std::make_unique<Model>(std::forward<Args>(args)...));
+    }
+
+    std::unique_ptr<Model> remove(std::size_t index) {
+        std::unique_ptr<Model> model = std::move(m_models[index]);
+        m_models.erase(m_models.begin() + static_cast<std::ptrdiff_t>(index));
+        repartition();
+        return model;
+    }
+
+    std::size_t size() const { return m_models.size(); }
+    unsigned numWorkers() const { return static_cast<unsigned>(m_workers.size()); }
+    Model& operator[](std::size_t index) { return *m_models[index]; }
+    const Model& operator[](std::size_t index) const { return *m_models[index]; }
+
+    // --- 核心更新 ---
+    void stepAll(double dt) {
+        forEach([dt](Model& model, std::size_t) { model.update(dt); });
+    }
+
+    // 在工作线程上并行执行 fn(model, index), 返回前所有调用均已完成
+    template<class Fn>
+    void forEach(Fn&& fn) {
+        const auto start = std::chrono::steady_clock::now();
+
+        m_task = [&fn](Model& model, std::size_t index) { fn(model, index); };
+        for (auto& worker : m_workers) worker.next.store(worker.begin, std::memory_order_relaxed);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending = static_cast<unsigned>(m_threads.size());
+            ++m_generation;
+        }
+        m_startCv.notify_all();
+
+        runWorker(0);
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_doneCv.wait(lock, [this] { return m_pending == 0; });
+        }
+        m_task = nullptr;
+
+        const auto end = std::chrono::steady_clock::now();
+        m_stats.wall_time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        for (std::size_t w = 0; w < m_workers.size(); ++w) {
+            m_stats.worker_busy_ms[w] = m_workers[w].busy_ms;
+            m_stats.worker_steps[w] = m_workers[w].steps;
+            m_stats.worker_steals[w] = m_workers[w].steals;
+        }
+    }
+
+    // --- 获取统计 ---
+    const FleetFrameStats& lastFrameStats() const { return m_stats; }
+
+private:
+    // 每个工作线程独占一条缓存行, 避免游标之间的伪共享
+    struct alignas(64) Worker {
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        std::atomic<std::size_t> next{0};
+        double busy_ms = 0.0;
+        std::size_t steps = 0;
+        std::size_t steals = 0;
+
+        Worker() = default;
+        Worker(const Worker& other) : begin(other.begin), end(other.end), next(other.next.load()) {}
+    };
+
+    // 将飞机平均划分为连续区间, 每个区间归属一个工作线程
+    void repartition() {
+        const std::size_t n = m_models.size();
+        const std::size_t w_count = m_workers.size();
+        for (std::size_t w = 0; w < w_count; ++w) {
+            m_workers[w].begin = n * w / w_count;
+            m_workers[w].end = n * (w + 1) / w_count;
+            m_workers[w].next.store(m_workers[w].begin, std::memory_order_relaxed);
+        }
+    }
+
+    void workerLoop(unsigned w) {
+        unsigned long long seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_startCv.wait(lock, [this, seen] { return m_generation != seen; });
+                seen = m_generation;
+                if (m_shutdown) return;
+            }
+            runWorker(w);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_pending == 0) m_doneCv.notify_one();
+            }
+        }
+    }
+
+    void runWorker(unsigned w) {
+        Worker& self = m_workers[w];
+        self.steps = 0;
+        self.steals = 0;
+        const auto start = std::chrono::steady_clock::now();
+
+        // 先推进归属本线程的飞机
+        for (std::size_t i = self.next.fetch_add(1, std::memory_order_relaxed); i < self.end;
+             i = self.next.fetch_add(1, std::memory_order_relaxed)) {
+            m_task(*m_models[i], i);
+            ++self.steps;
+        }
+
+        // 再从其他线程的区间中窃取
+        const std::size_t w_count = m_workers.size();
+        for (std::size_t k = 1; k < w_count; ++k) {
+            Worker& victim = m_workers[(w + k) % w_count];
+            for (std::size_t i = victim.next.fetch_add(1, std::memory_order_relaxed); i < victim.end;
+                 i = victim.next.fetch_add(1, std::memory_order_relaxed)) {
+                m_task(*m_models[i], i);
+                ++self.steps;
+                ++self.steals;
+            }
+        }
+
+        self.busy_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    static void pinThread(std::thread& thread, unsigned w) {
+#ifdef __linux__
+        const unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(w % cpus, &set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+        (void)thread;
+        (void)w;
+#endif
+    }
+
+    std::vector<std::unique_ptr<Model>> m_models;
+    std::vector<Worker> m_workers;
+    std::vector<std::thread> m_threads;
+    std::function<void(Model&, std::size_t)> m_task;
+
+    std::mutex m_mutex;
+    std::condition_variable m_startCv;
+    std::condition_variable m_doneCv;
+    unsigned long long m_generation = 0;
+    unsigned m_pending = 0;
+    bool m_shutdown = false;
+
+    FleetFrameStats m_stats;
+};
+
+#endif // FLEET_EXECUTOR_HPP
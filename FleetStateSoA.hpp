@@ -0,0 +1,218 @@
+// FleetStateSoA.hpp
+#ifndef FLEET_STATE_SOA_HPP
+#define FLEET_STATE_SOA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory>
+#include "JSBSimAircraftState.hpp"
+
+// --- 机群状态的结构数组(SoA)布局 ---
+// 每个字段一段连续、64字节对齐的数组, 下标为飞机槽位号;
+// 发动机数据按 engine_offset[slot] 展平到统一的发动机数组中。
+// 适合"对全机群扫描某一字段"的消费者(传感器、威胁模型), 可直接SIMD遍历。
+// 容量在构造时固定, 之后不再分配内存, 数组指针在对象生命周期内保持不变。
+class FleetStateSoA {
+public:
+    static constexpr std::size_t ALIGNMENT = 64;
+
+    FleetStateSoA(std::size_t max_aircraft, std::size_t max_engines_total)
+        : m_capacity(max_aircraft), m_engineCapacity(max_engines_total)
+    {
+        const std::size_t n = paddedCount<double>(max_aircraft);
+        const std::size_t ne = paddedCount<double>(max_engines_total);
+        const std::size_t ni = paddedCount<std::int32_t>(max_aircraft);
+        const std::size_t nb = paddedCount<std::uint8_t>(max_aircraft);
+        const std::size_t bytes = DOUBLE_FIELDS * n * sizeof(double) + ENGINE_FIELDS * ne * sizeof(double)
+                                + 2 * ni * sizeof(std::int32_t) + nb * sizeof(std::uint8_t);
+
+        m_block.reset(static_cast<unsigned char*>(::operator new(bytes, std::align_val_t(ALIGNMENT))));
+        std::fill(m_block.get(), m_block.get() + bytes, static_cast<unsigned char>(0));
+
+        unsigned char* cursor = m_block.get();
+        double** fields[DOUBLE_FIELDS] = {
+            &position_x, &position_y, &position_z,
+            &velocity_n, &velocity_e, &velocity_d,
+            &accel_n, &accel_e, &accel_d,
+            &altitude_sl_m,
+            &roll_rad, &pitch_rad, &yaw_rad,
+            &ang_vel_p, &ang_vel_q, &ang_vel_r,
+            &g_load, &mach, &alpha_rad, &beta_rad, &flight_path_rad, &calibrated_airspeed_kts,
+            &total_weight_lbs, &fuel_weight_lbs
+        };
+        for (double** field : fields) *field = carve<double>(cursor, n);
+
+        engine_thrust_lbf = carve<double>(cursor, ne);
+        engine_rpm = carve<double>(cursor, ne);
+        engine_fuel_flow_pph = carve<double>(cursor, ne);
+        engine_pla_pct = carve<double>(cursor, ne);
+
+        num_engines = carve<std::int32_t>(cursor, ni);
+        engine_offset = carve<std::int32_t>(cursor, ni);
+        on_ground = carve<std::uint8_t>(cursor, nb);
+    }
+
+    FleetStateSoA(const FleetStateSoA&) = delete;
+    FleetStateSoA& operator=(const FleetStateSoA&) = delete;
+    FleetStateSoA(FleetStateSoA&&) = default;
+    FleetStateSoA& operator=(FleetStateSoA&&) = default;
+
+    // --- 槽位管理 ---
+    // 分配一个槽位并预留其发动机区段, 容量不足时返回 npos
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    std::size_t addSlot(int engines) {
+        engines = std::max(0, engines);
+        if (m_size >= m_capacity || m_engineSize + static_cast<std::size_t>(engines) > m_engineCapacity) return npos;
+        const std::size_t slot = m_size++;
+        num_engines[slot] = engines;
+        engine_offset[slot] = static_cast<std::int32_t>(m_engineSize);
+        m_engineSize += static_cast<std::size_t>(engines);
+        return slot;
+    }
+
+    std::size_t size() const { return m_size; }
+    std::size_t capacity() const { return m_capacity; }
+    std::size_t engineCount() const { return m_engineSize; }
+
+    // --- 与 JSBSimAircraftState 互转 ---
+    void store(std::size_t slot, const JSBSimAircraftState& s) {
+        position_x[slot] = s.position_ned.x();
+        position_y[slot] = s.position_ned.y();
+        position_z[slot] = s.position_ned.z();
+        velocity_n[slot] = s.velocity_ned.x();
+        velocity_e[slot] = s.velocity_ned.y();
+        velocity_d[slot] = s.velocity_ned.z();
+        accel_n[slot] = s.accel_ned.x();
+        accel_e[slot] = s.accel_ned.y();
+        accel_d[slot] = s.accel_ned.z();
+        altitude_sl_m[slot] = s.altitude_sl_m;
+        roll_rad[slot] = s.roll_rad;
+        pitch_rad[slot] = s.pitch_rad;
+        yaw_rad[slot] = s.yaw_rad;
+        ang_vel_p[slot] = s.ang_vel_rps.x();
+        ang_vel_q[slot] = s.ang_vel_rps.y();
+        ang_vel_r[slot] = s.ang_vel_rps.z();
+        g_load[slot] = s.g_load;
+        mach[slot] = s.mach;
+        alpha_rad[slot] = s.alpha_rad;
+        beta_rad[slot] = s.beta_rad;
+        flight_path_rad[slot] = s.flight_path_rad;
+        calibrated_airspeed_kts[slot] = s.calibrated_airspeed_kts;
+        total_weight_lbs[slot] = s.total_weight_lbs;
+        fuel_weight_lbs[slot] = s.fuel_weight_lbs;
+        on_ground[slot] = s.on_ground ? 1 : 0;
+
+        const int engines = std::min(num_engines[slot], static_cast<int>(s.propulsion.size()));
+        const std::size_t base = static_cast<std::size_t>(engine_offset[slot]);
+        for (int i = 0; i < engines; ++i) {
+            engine_thrust_lbf[base + i] = s.propulsion[i].thrust_lbf;
+            engine_rpm[base + i] = s.propulsion[i].rpm;
+            engine_fuel_flow_pph[base + i] = s.propulsion[i].fuel_flow_pph;
+            engine_pla_pct[base + i] = s.propulsion[i].pla_pct;
+        }
+    }
+
+    void load(std::size_t slot, JSBSimAircraftState& s) const {
+        s.position_ned.set(position_x[slot], position_y[slot], position_z[slot]);
+        s.velocity_ned.set(velocity_n[slot], velocity_e[slot], velocity_d[slot]);
+        s.accel_ned.set(accel_n[slot], accel_e[slot], accel_d[slot]);
+        s.altitude_sl_m = altitude_sl_m[slot];
+        s.roll_rad = roll_rad[slot];
+        s.pitch_rad = pitch_rad[slot];
+        s.yaw_rad = yaw_rad[slot];
+        s.ang_vel_rps.set(ang_vel_p[slot], ang_vel_q[slot], ang_vel_r[slot]);
+        s.g_load = g_load[slot];
+        s.mach = mach[slot];
+        s.alpha_rad = alpha_rad[slot];
+        s.beta_rad = beta_rad[slot];
+        s.flight_path_rad = flight_path_rad[slot];
+        s.calibrated_airspeed_kts = calibrated_airspeed_kts[slot];
+        s.total_weight_lbs = total_weight_lbs[slot];
+        s.fuel_weight_lbs = fuel_weight_lbs[slot];
+        s.on_ground = on_ground[slot] != 0;
+
+        s.num_engines = num_engines[slot];
+        s.propulsion.resize(static_cast<std::size_t>(s.num_engines));
+        const std::size_t base = static_cast<std::size_t>(engine_offset[slot]);
+        for (int i = 0; i < s.num_engines; ++i) {
+            s.propulsion[i].thrust_lbf = engine_thrust_lbf[base + i];
+            s.propulsion[i].rpm = engine_rpm[base + i];
+            s.propulsion[i].fuel_flow_pph = engine_fuel_flow_pph[base + i];
+            s.propulsion[i].pla_pct = engine_pla_pct[base + i];
+        }
+    }
+
+    // --- 运动学 ---
+    double* position_x = nullptr;       // 与 JSBSimAircraftState::position_ned 含义一致
+    double* position_y = nullptr;
+    double* position_z = nullptr;
+    double* velocity_n = nullptr;       // 米/秒
+    double* velocity_e = nullptr;
+    double* velocity_d = nullptr;
+    double* accel_n = nullptr;          // 米/秒^2
+    double* accel_e = nullptr;
+    double* accel_d = nullptr;
+    double* altitude_sl_m = nullptr;
+
+    // --- 姿态 ---
+    double* roll_rad = nullptr;
+    double* pitch_rad = nullptr;
+    double* yaw_rad = nullptr;
+    double* ang_vel_p = nullptr;        // 弧度/秒
+    double* ang_vel_q = nullptr;
+    double* ang_vel_r = nullptr;
+
+    // --- 空气动力学 ---
+    double* g_load = nullptr;
+    double* mach = nullptr;
+    double* alpha_rad = nullptr;
+    double* beta_rad = nullptr;
+    double* flight_path_rad = nullptr;
+    double* calibrated_airspeed_kts = nullptr;
+
+    // --- 系统与重量 ---
+    double* total_weight_lbs = nullptr;
+    double* fuel_weight_lbs = nullptr;
+    std::uint8_t* on_ground = nullptr;
+
+    // --- 发动机(按 engine_offset[slot] + i 索引) ---
+    std::int32_t* num_engines = nullptr;
+    std::int32_t* engine_offset = nullptr;
+    double* engine_thrust_lbf = nullptr;
+    double* engine_rpm = nullptr;
+    double* engine_fuel_flow_pph = nullptr;
+    double* engine_pla_pct = nullptr;
+
+private:
+    static constexpr std::size_t DOUBLE_FIELDS = 24;
+    static constexpr std::size_t ENGINE_FIELDS = 4;
+
+    struct AlignedDelete {
+        void operator()(unsigned char* p) const { ::operator delete(p, std::align_val_t(ALIGNMENT)); }
+    };
+
+    // 元素个数向上取整到整条缓存行, 保证每个数组都从64字节边界开始
+    template<class T>
+    static std::size_t paddedCount(std::size_t count) {
+        const std::size_t per_line = ALIGNMENT / sizeof(T);
+        return std::max<std::size_t>(per_line, (count + per_line - 1) / per_line * per_line);
+    }
+
+    template<class T>
+    static T* carve(unsigned char*& cursor, std::size_t count) {
+        T* p = reinterpret_cast<T*>(cursor);
+        cursor += count * sizeof(T);
+        return p;
+    }
+
+    std::unique_ptr<unsigned char, AlignedDelete> m_block;
+    std::size_t m_capacity = 0;
+    std::size_t m_engineCapacity = 0;
+    std::size_t m_size = 0;
+    std::size_t m_engineSize = 0;
+};
+
+#endif // FLEET_STATE_SOA_HPP
@@ -0,0 +1,117 @@
+// FrameScheduler.cpp
+#include "FrameScheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+double toUs(FrameScheduler::Clock::duration d) {
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+// 帧率须为有限正数, 且周期不小于时钟精度
+double checkedRate(double rate_hz) {
+    if (!(rate_hz > 0.0) || !std::isfinite(rate_hz) ||
+        std::chrono::duration_cast<FrameScheduler::Clock::duration>(std::chrono::duration<double>(1.0 / rate_hz)).count() <= 0) {
+        throw std::invalid_argument("FrameScheduler: invalid frame rate " + std::to_string(rate_hz) + " Hz");
+    }
+    return rate_hz;
+}
+}
+
+FrameScheduler::FrameScheduler(double rate_hz, OverrunPolicy policy, double spin_threshold_us,
+                               double jitter_bin_us, std::size_t jitter_bins)
+    : m_periodSec(1.0 / checkedRate(rate_hz)),
+      m_period(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate_hz))),
+      m_spinThreshold(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::micro>(spin_threshold_us))),
+      m_policy(policy)
+{
+    m_stats.jitter_bin_us = jitter_bin_us;
+    m_stats.jitter_histogram.assign(jitter_bins + 1, 0);
+}
+
+void FrameScheduler::start() {
+    const double bin_us = m_stats.jitter_bin_us;
+    const std::size_t bins = m_stats.jitter_histogram.size();
+    m_stats = Stats{};
+    m_stats.jitter_bin_us = bin_us;
+    m_stats.jitter_histogram.assign(bins, 0);
+
+    m_origin = Clock::now();
+    m_nextTick = 0;
+}
+
+// 先睡到截止时刻前 spin_threshold, 再自旋到截止时刻
+void FrameScheduler::waitUntil(Clock::time_point deadline) const {
+    if (deadline - Clock::now() > m_spinThreshold) {
+        std::this_thread::sleep_until(deadline - m_spinThreshold);
+    }
+    while (Clock::now() < deadline) {
+        // 自旋
+    }
+}
+
+int FrameScheduler::waitNextFrame() {
+    Clock::time_point deadline = m_origin + m_period * static_cast<Clock::rep>(m_nextTick);
+    Clock::time_point now = Clock::now();
+    int frames = 1;
+
+    if (now < deadline) {
+        waitUntil(deadline);
+        now = Clock::now();
+        ++m_nextTick;
+    } else {
+        // 已落后: 计算错过的完整节拍数, 按策略补跑或丢弃
+        const std::uint64_t behind = static_cast<std::uint64_t>((now - deadline) / m_period);
+        if (m_policy == OverrunPolicy::CatchUp) {
+            const std::uint64_t extra = std::min<std::uint64_t>(behind, static_cast<std::uint64_t>(m_maxCatchUp - 1));
+            frames += static_cast<int>(extra);
+            m_stats.caught_up_frames += extra;
+            m_stats.dropped_frames += behind - extra;
+        } else {
+            m_stats.dropped_frames += behind;
+        }
+        m_nextTick += behind + 1;
+        deadline += m_period * static_cast<Clock::rep>(behind);
+    }
+
+    // 唤醒抖动: 实际唤醒时刻相对节拍的延迟
+    const double jitter_us = toUs(now - deadline);
+    m_stats.max_jitter_us = std::max(m_stats.max_jitter_us, jitter_us);
+    const std::size_t last = m_stats.jitter_histogram.size() - 1;
+    const std::size_t bin = static_cast<std::size_t>(std::max(0.0, jitter_us) / m_stats.jitter_bin_us);
+    ++m_stats.jitter_histogram[std::min(bin, last)];
+
+    m_frameWake = now;
+    m_stats.frames += static_cast<std::uint64_t>(frames);
+    return frames;
+}
+
+void FrameScheduler::endFrame() {
+    const Clock::time_point now = Clock::now();
+    m_stats.last_exec_us = toUs(now - m_frameWake);
+    m_stats.max_exec_us = std::max(m_stats.max_exec_us, m_stats.last_exec_us);
+
+    const Clock::time_point next_deadline = m_origin + m_period * static_cast<Clock::rep>(m_nextTick);
+    if (now > next_deadline) {
+        ++m_stats.missed_deadlines;
+        m_stats.max_overrun_us = std::max(m_stats.max_overrun_us, toUs(now - next_deadline));
+    }
+}
+
+double FrameScheduler::Stats::jitterPercentileUs(double p) const {
+    std::uint64_t total = 0;
+    for (std::uint64_t n : jitter_histogram) total += n;
+    if (total == 0) return 0.0;
+
+    const double target = std::min(100.0, std::max(0.0, p)) / 100.0 * static_cast<double>(total);
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < jitter_histogram.size(); ++i) {
+        cumulative += jitter_histogram[i];
+        if (static_cast<double>(cumulative) >= target) return (i + 1) * jitter_bin_us;
+    }
+    return jitter_histogram.size() * jitter_bin_us;
+}
@@ -0,0 +1,74 @@
+// FrameScheduler.hpp
+#ifndef FRAME_SCHEDULER_HPP
+#define FRAME_SCHEDULER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// --- 实时固定帧率调度器 ---
+// 按绝对单调时间轴 t_k = t0 + k * period 节拍推进, 不因单帧耗时累积漂移。
+// 等待采用"先睡眠、最后一段自旋"的混合方式, 兼顾CPU占用与唤醒精度。
+// 用法:
+//     FrameScheduler sched(120.0);
+//     sched.start();
+//     for (;;) {
+//         const int n = sched.waitNextFrame();   // 超时后按策略可能 > 1
+//         for (int i = 0; i < n; ++i) aircraft.update(sched.period());
+//         sched.endFrame();
+//     }
+class FrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class OverrunPolicy {
+        CatchUp, // 落后的帧连续补跑(每次最多 maxCatchUp 帧), 保持仿真时间与墙钟一致
+        Drop     // 丢弃落后的帧, 直接对齐到最近的节拍, 仿真时间相对墙钟变慢
+    };
+
+    struct Stats {
+        std::uint64_t frames = 0;            // 已执行的帧数(含补跑)
+        std::uint64_t missed_deadlines = 0;  // 帧结束时已超过下一节拍的次数
+        std::uint64_t dropped_frames = 0;    // 被丢弃的节拍数
+        std::uint64_t caught_up_frames = 0;  // 补跑的帧数
+        double last_exec_us = 0.0;           // 最近一帧从唤醒到 endFrame() 的耗时
+        double max_exec_us = 0.0;
+        double max_overrun_us = 0.0;         // 超出下一节拍的最大时长
+        double max_jitter_us = 0.0;          // 相对节拍的最大唤醒延迟
+
+        // 唤醒抖动直方图: 第 i 格统计 [i*bin_us, (i+1)*bin_us) 的次数, 最后一格为溢出
+        double jitter_bin_us = 10.0;
+        std::vector<std::uint64_t> jitter_histogram;
+
+        // 由直方图估计抖动的百分位数(微秒), p 取 0-100
+        double jitterPercentileUs(double p) const;
+    };
+
+    // rate_hz 不是有限正数时抛出 std::invalid_argument
+    explicit FrameScheduler(double rate_hz, OverrunPolicy policy = OverrunPolicy::CatchUp,
+                            double spin_threshold_us = 500.0, double jitter_bin_us = 10.0, std::size_t jitter_bins = 100);
+
+    void start();         // 以当前时刻为时间轴零点, 清空统计
+    int waitNextFrame();  // 等到下一节拍, 返回本节拍应执行的帧数
+    void endFrame();      // 帧结束, 记录耗时与超时
+
+    double period() const { return m_periodSec; }
+    void setMaxCatchUp(int frames) { m_maxCatchUp = frames < 1 ? 1 : frames; }
+    const Stats& stats() const { return m_stats; }
+
+private:
+    void waitUntil(Clock::time_point deadline) const;
+
+    double m_periodSec;
+    Clock::duration m_period;
+    Clock::duration m_spinThreshold;
+    OverrunPolicy m_policy;
+    int m_maxCatchUp = 4;
+
+    Clock::time_point m_origin;
+    std::uint64_t m_nextTick = 0;         // 下一个节拍序号
+    Clock::time_point m_frameWake;        // 当前帧实际唤醒时刻
+    Stats m_stats;
+};
+
+#endif // FRAME_SCHEDULER_HPP
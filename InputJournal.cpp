@@ -0,0 +1,388 @@
+// InputJournal.cpp
+#include "InputJournal.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+using namespace input_journal;
+
+namespace {
+
+const std::size_t FLUSH_BYTES = 1 << 16;
+
+std::uint64_t doubleBits(double v) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+double bitsDouble(std::uint64_t bits) {
+    double v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+int trailingZeros(std::uint64_t v) {
+    if (v == 0) return 64;
+    int n = 0;
+    while ((v & 1u) == 0) {
+        v >>= 1;
+        ++n;
+    }
+    return n;
+}
+
+struct Fnv1a {
+    std::uint64_t hash = 1469598103934665603ull;
+    void add(const void* data, std::size_t n) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < n; ++i) {
+            hash ^= p[i];
+            hash *= 1099511628211ull;
+        }
+    }
+    void add(double v) { add(&v, sizeof(v)); }
+    void add(const oe_base::Vec3d& v) { add(v.x()); add(v.y()); add(v.z()); }
+};
+
+// Controls 记录中按有效位顺序出现的双精度字段
+struct ControlField {
+    std::uint32_t flag;
+    int channel;
+    double ControlFrame::* member;
+};
+
+const ControlField CONTROL_FIELDS[] = {
+    {ControlFrame::Roll, ChRoll, &ControlFrame::roll},
+    {ControlFrame::Pitch, ChPitch, &ControlFrame::pitch},
+    {ControlFrame::Rudder, ChRudder, &ControlFrame::rudder},
+    {ControlFrame::ThrottleAll, ChThrottleAll, &ControlFrame::throttle_all},
+    {ControlFrame::Brakes, ChBrakeLeft, &ControlFrame::brake_left},
+    {ControlFrame::Brakes, ChBrakeRight, &ControlFrame::brake_right},
+    {ControlFrame::SpeedBrake, ChSpeedBrake, &ControlFrame::speed_brake},
+    {ControlFrame::TrimRoll, ChTrimRoll, &ControlFrame::trim_roll},
+    {ControlFrame::TrimPitch, ChTrimPitch, &ControlFrame::trim_pitch},
+};
+
+} // namespace
+
+// --- 状态校验和 ---
+std::uint64_t input_journal::stateChecksum(const JSBSimAircraftState& s) {
+    Fnv1a f;
+    f.add(s.position_ned);
+    f.add(s.velocity_ned);
+    f.add(s.accel_ned);
+    f.add(s.altitude_sl_m);
+    f.add(s.roll_rad);
+    f.add(s.pitch_rad);
+    f.add(s.yaw_rad);
+    f.add(s.ang_vel_rps);
+    f.add(s.g_load);
+    f.add(s.mach);
+    f.add(s.alpha_rad);
+    f.add(s.beta_rad);
+    f.add(s.flight_path_rad);
+    f.add(s.calibrated_airspeed_kts);
+    f.add(s.total_weight_lbs);
+    f.add(s.fuel_weight_lbs);
+    const unsigned char on_ground = s.on_ground ? 1 : 0;
+    f.add(&on_ground, 1);
+    for (int i = 0; i < s.num_engines; ++i) {
+        const PropulsionState& p = s.propulsion[i];
+        f.add(p.thrust_lbf);
+        f.add(p.rpm);
+        f.add(p.fuel_flow_pph);
+        f.add(p.pla_pct);
+    }
+    return f.hash;
+}
+
+// --- InputJournalWriter ---
+bool InputJournalWriter::open(const std::string& path, std::uint32_t checksum_interval) {
+    close();
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        std::cerr << "InputJournalWriter: Failed to open " << path << std::endl;
+        return false;
+    }
+    m_checksumInterval = checksum_interval > 0 ? checksum_interval : 1;
+    m_failed = false;
+    m_buffer.clear();
+    m_buffer.reserve(FLUSH_BYTES * 2);
+    m_bytes = 0;
+    std::fill(std::begin(m_prev), std::end(m_prev), 0.0);
+    m_pendingDt = 0.0;
+    m_pendingUpdates = 0;
+    m_updatesSinceChecksum = 0;
+
+    for (char c : MAGIC) putByte(static_cast<std::uint8_t>(c));
+    putVarint(m_checksumInterval);
+    return true;
+}
+
+bool InputJournalWriter::close() {
+    if (!m_file) return !m_failed;
+    flushUpdates();
+    flushBuffer();
+    if (std::fclose(m_file) != 0 && !m_failed) {
+        m_failed = true;
+        std::cerr << "InputJournalWriter: Failed to close the journal" << std::endl;
+    }
+    m_file = nullptr;
+    return !m_failed;
+}
+
+bool InputJournalWriter::flush() {
+    if (!m_file) return !m_failed;
+    flushUpdates();
+    flushBuffer();
+    if (!m_failed && std::fflush(m_file) != 0) {
+        m_failed = true;
+        std::cerr << "InputJournalWriter: Failed to flush the journal" << std::endl;
+    }
+    return !m_failed;
+}
+
+void InputJournalWriter::writeInit(const std::string& jsbsim_root_dir, const std::string& aircraft_model) {
+    if (!m_file) return;
+    flushUpdates();
+    putByte(static_cast<std::uint8_t>(Op::Init));
+    putString(jsbsim_root_dir);
+    putString(aircraft_model);
+}
+
+void InputJournalWriter::writeInitialConditions(double lat_deg, double lon_deg, double alt_m, double hdg_deg, double speed_kts) {
+    if (!m_file) return;
+    flushUpdates();
+    putByte(static_cast<std::uint8_t>(Op::InitialConditions));
+    putDouble(ChLat, lat_deg);
+    putDouble(ChLon, lon_deg);
+    putDouble(ChAlt, alt_m);
+    putDouble(ChHdg, hdg_deg);
+    putDouble(ChSpeed, speed_kts);
+}
+
+void InputJournalWriter::writeRunIC(bool result) {
+    if (!m_file) return;
+    flushUpdates();
+    putByte(static_cast<std::uint8_t>(Op::RunIC));
+    putByte(result ? 1 : 0);
+    m_updatesSinceChecksum = 0;
+}
+
+// 相同 dt 的连续 update 先累计, 遇到其他记录或 dt 改变时合并写出
+void InputJournalWriter::writeUpdate(double dt) {
+    if (!m_file) return;
+    if (m_pendingUpdates > 0 && doubleBits(dt) != doubleBits(m_pendingDt)) flushUpdates();
+    m_pendingDt = dt;
+    ++m_pendingUpdates;
+    ++m_updatesSinceChecksum;
+}
+
+void InputJournalWriter::writeControls(const ControlFrame& controls) {
+    if (!m_file) return;
+    flushUpdates();
+    putByte(static_cast<std::uint8_t>(Op::Controls));
+    putVarint(controls.valid);
+    if (controls.valid & ControlFrame::Throttle) putVarint(controls.throttle_engines);
+    for (const ControlField& f : CONTROL_FIELDS) {
+        if (controls.valid & f.flag) putDouble(f.channel, controls.*f.member);
+    }
+    if (controls.valid & ControlFrame::Throttle) {
+        for (int i = 0; i < ControlFrame::MAX_ENGINES; ++i) {
+            if (controls.throttle_engines & (1u << i)) putDouble(ChThrottle0 + i, controls.throttle[i]);
+        }
+    }
+    if (controls.valid & ControlFrame::Gear) putByte(controls.gear_down ? 1 : 0);
+}
+
+void InputJournalWriter::writeChecksum(std::uint64_t checksum) {
+    if (!m_file) return;
+    flushUpdates();
+    putByte(static_cast<std::uint8_t>(Op::Checksum));
+    putVarint(m_updatesSinceChecksum);
+    for (int i = 0; i < 8; ++i) putByte(static_cast<std::uint8_t>(checksum >> (8 * i)));
+    m_updatesSinceChecksum = 0;
+    // 校验点处落盘, 崩溃后日志可回放到最后一个校验点
+    flush();
+}
+
+void InputJournalWriter::flushUpdates() {
+    if (m_pendingUpdates == 0) return;
+    putByte(static_cast<std::uint8_t>(Op::Update));
+    putDouble(ChDt, m_pendingDt);
+    putVarint(m_pendingUpdates);
+    m_pendingUpdates = 0;
+    if (m_buffer.size() >= FLUSH_BYTES) flushBuffer();
+}
+
+// 写盘失败后丢弃缓冲, 不再写入: 残缺的记录之后再追加内容只会让回放在错误的位置报损坏
+void InputJournalWriter::flushBuffer() {
+    if (!m_file || m_buffer.empty()) return;
+    if (!m_failed) {
+        const std::size_t written = std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+        m_bytes += written;
+        if (written != m_buffer.size()) {
+            m_failed = true;
+            std::cerr << "InputJournalWriter: Failed to write the journal (" << written << " of " << m_buffer.size()
+                      << " bytes written)" << std::endl;
+        }
+    }
+    m_buffer.clear();
+}
+
+void InputJournalWriter::putVarint(std::uint64_t v) {
+    while (v >= 0x80) {
+        putByte(static_cast<std::uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    putByte(static_cast<std::uint8_t>(v));
+}
+
+void InputJournalWriter::putDouble(int channel, double v) {
+    const std::uint64_t x = doubleBits(v) ^ doubleBits(m_prev[channel]);
+    const int tz = trailingZeros(x);
+    putByte(static_cast<std::uint8_t>(tz));
+    if (tz < 64) putVarint(x >> tz);
+    m_prev[channel] = v;
+}
+
+void InputJournalWriter::putString(const std::string& s) {
+    putVarint(s.size());
+    m_buffer.insert(m_buffer.end(), s.begin(), s.end());
+}
+
+// --- InputJournalReader ---
+bool InputJournalReader::open(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        std::cerr << "InputJournalReader: Failed to open " << path << std::endl;
+        return false;
+    }
+    m_data.clear();
+    unsigned char chunk[1 << 16];
+    std::size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) m_data.insert(m_data.end(), chunk, chunk + n);
+    std::fclose(file);
+
+    m_pos = 0;
+    m_corrupt = false;
+    std::fill(std::begin(m_prev), std::end(m_prev), 0.0);
+    std::uint64_t interval = 0;
+    if (m_data.size() < sizeof(MAGIC) || std::memcmp(m_data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "InputJournalReader: " << path << " is not an input journal" << std::endl;
+        return false;
+    }
+    m_pos = sizeof(MAGIC);
+    if (!getVarint(interval)) return false;
+    m_checksumInterval = static_cast<std::uint32_t>(interval);
+    return true;
+}
+
+bool InputJournalReader::next(JournalRecord& r) {
+    std::uint8_t op;
+    if (!getByte(op)) return false; // 正常结束
+    r.op = static_cast<Op>(op);
+
+    bool ok = true;
+    switch (r.op) {
+    case Op::Init:
+        ok = getString(r.root) && getString(r.model);
+        break;
+    case Op::InitialConditions:
+        for (int i = 0; i < 5 && ok; ++i) ok = getDouble(ChLat + i, r.ic[i]);
+        break;
+    case Op::RunIC: {
+        std::uint8_t b = 0;
+        ok = getByte(b);
+        r.result = b != 0;
+        break;
+    }
+    case Op::Update:
+        ok = getDouble(ChDt, r.dt) && getVarint(r.count);
+        break;
+    case Op::Controls: {
+        ControlFrame& c = r.controls;
+        c = ControlFrame();
+        std::uint64_t v = 0;
+        ok = getVarint(v);
+        c.valid = static_cast<std::uint32_t>(v);
+        if (ok && (c.valid & ControlFrame::Throttle)) {
+            ok = getVarint(v);
+            c.throttle_engines = static_cast<std::uint32_t>(v);
+        }
+        for (const ControlField& f : CONTROL_FIELDS) {
+            if (ok && (c.valid & f.flag)) ok = getDouble(f.channel, c.*f.member);
+        }
+        if (ok && (c.valid & ControlFrame::Throttle)) {
+            for (int i = 0; i < ControlFrame::MAX_ENGINES && ok; ++i) {
+                if (c.throttle_engines & (1u << i)) ok = getDouble(ChThrottle0 + i, c.throttle[i]);
+            }
+        }
+        if (ok && (c.valid & ControlFrame::Gear)) {
+            std::uint8_t b = 0;
+            ok = getByte(b);
+            c.gear_down = b != 0;
+        }
+        break;
+    }
+    case Op::Checksum: {
+        ok = getVarint(r.count);
+        r.checksum = 0;
+        for (int i = 0; i < 8 && ok; ++i) {
+            std::uint8_t b = 0;
+            ok = getByte(b);
+            r.checksum |= static_cast<std::uint64_t>(b) << (8 * i);
+        }
+        break;
+    }
+    default:
+        ok = false;
+        break;
+    }
+
+    if (!ok) {
+        m_corrupt = true;
+        std::cerr << "InputJournalReader: corrupt record at offset " << m_pos << std::endl;
+    }
+    return ok;
+}
+
+bool InputJournalReader::getByte(std::uint8_t& b) {
+    if (m_pos >= m_data.size()) return false;
+    b = m_data[m_pos++];
+    return true;
+}
+
+bool InputJournalReader::getVarint(std::uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        std::uint8_t b;
+        if (!getByte(b)) return false;
+        v |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+bool InputJournalReader::getDouble(int channel, double& v) {
+    std::uint8_t tz;
+    if (!getByte(tz) || tz > 64) return false;
+    std::uint64_t x = 0;
+    if (tz < 64) {
+        if (!getVarint(x)) return false;
+        x <<= tz;
+    }
+    v = bitsDouble(x ^ doubleBits(m_prev[channel]));
+    m_prev[channel] = v;
+    return true;
+}
+
+bool InputJournalReader::getString(std::string& s) {
+    std::uint64_t n = 0;
+    if (!getVarint(n) || n > m_data.size() - m_pos) return false;
+    s.assign(reinterpret_cast<const char*>(m_data.data() + m_pos), static_cast<std::size_t>(n));
+    m_pos += static_cast<std::size_t>(n);
+    return true;
+}
@@ -0,0 +1,258 @@
+// InputJournal.hpp
+#ifndef INPUT_JOURNAL_HPP
+#define INPUT_JOURNAL_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "ControlFrame.hpp"
+#include "JSBSimAircraftState.hpp"
+
+// --- 输入日志文件格式 (.jij) ---
+// 只记录输入: init 的模型、初始条件、RunIC、每次 update 的 dt 和所有控制指令,
+// 外加每隔若干帧的状态校验和。回放时把同样的输入喂给新的模型实例, 逐个核对校验和。
+// [文件头: "JSBJIJ01" + varint 校验间隔][记录...]
+// 每条记录: [操作码 1字节][负载]
+//   Init:        varint长度 + 根目录, varint长度 + 模型名
+//   InitialCond: 5 个压缩double(lat, lon, alt_m, hdg_deg, speed_kts)
+//   RunIC:       1字节结果
+//   Update:      压缩double dt + varint 连续次数(相同 dt 的连续 update 合并为一条)
+//   Controls:    varint 有效位掩码 [+ varint 逐台油门掩码] + 各有效字段
+//   Checksum:    varint 距上一个校验点的 update 次数 + 8字节校验和
+// 压缩double: 与同一通道上一个值按位异或, 写 [末尾零位数 1字节][varint(异或值 >> 末尾零位数)],
+// 数值不变时只占 1 字节, 杆量等"整齐"的数值通常 2~4 字节。
+namespace input_journal {
+
+constexpr char MAGIC[8] = {'J', 'S', 'B', 'J', 'I', 'J', '0', '1'};
+
+enum class Op : std::uint8_t {
+    Init = 1,
+    InitialConditions = 2,
+    RunIC = 3,
+    Update = 4,
+    Controls = 5,
+    Checksum = 6
+};
+
+// 双精度通道: 每个通道保存上一个值用于异或
+enum Channel {
+    ChLat, ChLon, ChAlt, ChHdg, ChSpeed,
+    ChDt,
+    ChRoll, ChPitch, ChRudder, ChThrottleAll,
+    ChBrakeLeft, ChBrakeRight, ChSpeedBrake, ChTrimRoll, ChTrimPitch,
+    ChThrottle0,
+    ChannelCount = ChThrottle0 + ControlFrame::MAX_ENGINES
+};
+
+// 对状态中所有数值字段的原始位做 FNV-1a, 用于判断回放是否逐位一致
+std::uint64_t stateChecksum(const JSBSimAircraftState& state);
+
+} // namespace input_journal
+
+// --- 日志记录 ---
+// 记录写入内存缓冲, 超过 64KB 或写入校验和记录时写盘并 fflush, 进程崩溃时最多丢失一个校验间隔;
+// 只能由一个线程调用。写盘失败后 failed() 为 true, 之后的记录不再写入。
+class InputJournalWriter {
+public:
+    InputJournalWriter() = default;
+    ~InputJournalWriter() { close(); }
+    InputJournalWriter(const InputJournalWriter&) = delete;
+    InputJournalWriter& operator=(const InputJournalWriter&) = delete;
+
+    bool open(const std::string& path, std::uint32_t checksum_interval = 60);
+    // 写出所有缓冲的记录并关闭文件, 此前或此时写盘失败返回 false
+    bool close();
+    // 写出所有缓冲的记录(含尚未合并写出的 update)并 fflush, 写盘失败返回 false
+    bool flush();
+    bool isOpen() const { return m_file != nullptr; }
+    bool failed() const { return m_failed; }
+    std::uint32_t checksumInterval() const { return m_checksumInterval; }
+    std::uint64_t bytesWritten() const { return m_bytes + m_buffer.size(); }
+
+    void writeInit(const std::string& jsbsim_root_dir, const std::string& aircraft_model);
+    void writeInitialConditions(double lat_deg, double lon_deg, double alt_m, double hdg_deg, double speed_kts);
+    void writeRunIC(bool result);
+    void writeUpdate(double dt);
+    void writeControls(const ControlFrame& controls);
+    void writeChecksum(std::uint64_t checksum);
+
+private:
+    void flushUpdates();
+    void flushBuffer();
+    void putByte(std::uint8_t b) { m_buffer.push_back(b); }
+    void putVarint(std::uint64_t v);
+    void putDouble(int channel, double v);
+    void putString(const std::string& s);
+
+    std::FILE* m_file = nullptr;
+    std::vector<std::uint8_t> m_buffer;
+    std::uint64_t m_bytes = 0;
+    std::uint32_t m_checksumInterval = 60;
+    bool m_failed = false;
+
+    double m_prev[input_journal::ChannelCount] = {};
+    double m_pendingDt = 0.0;
+    std::uint64_t m_pendingUpdates = 0;
+    std::uint64_t m_updatesSinceChecksum = 0;
+};
+
+// --- 日志读取 ---
+struct JournalRecord {
+    input_journal::Op op = input_journal::Op::Init;
+    std::string root;
+    std::string model;
+    double ic[5] = {};
+    bool result = false;
+    double dt = 0.0;
+    std::uint64_t count = 0;      // Update: 连续次数; Checksum: 距上一个校验点的 update 次数
+    ControlFrame controls;
+    std::uint64_t checksum = 0;
+};
+
+class InputJournalReader {
+public:
+    bool open(const std::string& path);
+    std::uint32_t checksumInterval() const { return m_checksumInterval; }
+    // 读取下一条记录; 文件结束或数据损坏时返回 false, 损坏时 corrupt() 为 true
+    bool next(JournalRecord& record);
+    bool corrupt() const { return m_corrupt; }
+
+private:
+    bool getByte(std::uint8_t& b);
+    bool getVarint(std::uint64_t& v);
+    bool getDouble(int channel, double& v);
+    bool getString(std::string& s);
+
+    std::vector<std::uint8_t> m_data;
+    std::size_t m_pos = 0;
+    std::uint32_t m_checksumInterval = 0;
+    bool m_corrupt = false;
+    double m_prev[input_journal::ChannelCount] = {};
+};
+
+// --- 记录装饰器 ---
+// 包装一个模型实例, 转发所有调用并写入日志; 控制指令统一经 applyControls() 施加, 保证记录与回放走同一路径。
+// 经 setCommandQueue() 等旁路施加的指令不会被记录。模型缓存、多速率等配置须在回放时同样设置。
+template<class Model>
+class RecordingAircraft {
+public:
+    RecordingAircraft(Model& model, InputJournalWriter& journal) : m_model(model), m_journal(journal) {}
+
+    bool init(const std::string& jsbsim_root_dir, const std::string& aircraft_model) {
+        m_journal.writeInit(jsbsim_root_dir, aircraft_model);
+        return m_model.init(jsbsim_root_dir, aircraft_model);
+    }
+    void setInitialConditions(double lat_deg, double lon_deg, double alt_m, double hdg_deg, double speed_kts) {
+        m_journal.writeInitialConditions(lat_deg, lon_deg, alt_m, hdg_deg, speed_kts);
+        m_model.setInitialConditions(lat_deg, lon_deg, alt_m, hdg_deg, speed_kts);
+    }
+    bool runInitialConditions() {
+        const bool result = m_model.runInitialConditions();
+        m_journal.writeRunIC(result);
+        m_updates = 0;
+        return result;
+    }
+
+    void update(double dt) {
+        m_journal.writeUpdate(dt);
+        m_model.update(dt);
+        if (++m_updates % m_journal.checksumInterval() == 0) {
+            m_journal.writeChecksum(input_journal::stateChecksum(m_model.getState()));
+        }
+    }
+
+    void setControlStickRoll(double norm_val) { applyControls(ControlFrame().setRoll(norm_val)); }
+    void setControlStickPitch(double norm_val) { applyControls(ControlFrame().setPitch(norm_val)); }
+    void setRudderPedal(double norm_val) { applyControls(ControlFrame().setRudder(norm_val)); }
+    void setThrottle(int engine_idx, double norm_val) { applyControls(ControlFrame().setThrottle(engine_idx, norm_val)); }
+    void setThrottles(double norm_val) { applyControls(ControlFrame().setThrottles(norm_val)); }
+    void setGearHandle(bool down) { applyControls(ControlFrame().setGearHandle(down)); }
+    void setBrakes(double left, double right) { applyControls(ControlFrame().setBrakes(left, right)); }
+    void setSpeedBrakes(double norm_val) { applyControls(ControlFrame().setSpeedBrakes(norm_val)); }
+    void setTrimSwitchRoll(double val) { applyControls(ControlFrame().setTrimSwitchRoll(val)); }
+    void setTrimSwitchPitch(double val) { applyControls(ControlFrame().setTrimSwitchPitch(val)); }
+    void applyControls(const ControlFrame& controls) {
+        m_journal.writeControls(controls);
+        m_model.applyControls(controls);
+    }
+
+    const JSBSimAircraftState& getState() const { return m_model.getState(); }
+    Model& model() { return m_model; }
+
+private:
+    Model& m_model;
+    InputJournalWriter& m_journal;
+    std::uint64_t m_updates = 0;
+};
+
+// --- 回放 ---
+struct ReplayResult {
+    bool ok = false;                   // 日志完整读完且所有校验和一致
+    bool init_failed = false;
+    std::uint64_t updates = 0;
+    double sim_time_s = 0.0;
+    double wall_time_s = 0.0;
+    std::uint64_t checksums_checked = 0;
+    std::uint64_t mismatches = 0;
+    std::int64_t first_mismatch_update = -1;
+};
+
+// 以CPU允许的最快速度把日志喂给 model(须为未 init 的新实例, 缓存等配置已设置好)。
+// root_override 非空时替换日志中的JSBSim根目录; stop_on_mismatch 为 true 时在第一次不一致处停止
+template<class Model>
+ReplayResult replayJournal(const std::string& path, Model& model, const std::string& root_override = std::string(),
+                           bool stop_on_mismatch = false) {
+    ReplayResult result;
+    InputJournalReader reader;
+    if (!reader.open(path)) return result;
+
+    const auto start = std::chrono::steady_clock::now();
+    JournalRecord r;
+    std::uint64_t since_checksum = 0;
+    bool stopped = false;
+    while (!stopped && reader.next(r)) {
+        switch (r.op) {
+        case input_journal::Op::Init:
+            if (!model.init(root_override.empty() ? r.root : root_override, r.model)) {
+                result.init_failed = true;
+                stopped = true;
+            }
+            break;
+        case input_journal::Op::InitialConditions:
+            model.setInitialConditions(r.ic[0], r.ic[1], r.ic[2], r.ic[3], r.ic[4]);
+            break;
+        case input_journal::Op::RunIC:
+            if (model.runInitialConditions() != r.result) ++result.mismatches;
+            since_checksum = 0;
+            break;
+        case input_journal::Op::Update:
+            for (std::uint64_t i = 0; i < r.count; ++i) {
+                model.update(r.dt);
+                result.sim_time_s += r.dt;
+            }
+            result.updates += r.count;
+            since_checksum += r.count;
+            break;
+        case input_journal::Op::Controls:
+            model.applyControls(r.controls);
+            break;
+        case input_journal::Op::Checksum:
+            ++result.checksums_checked;
+            if (since_checksum != r.count || input_journal::stateChecksum(model.getState()) != r.checksum) {
+                if (result.first_mismatch_update < 0) result.first_mismatch_update = static_cast<std::int64_t>(result.updates);
+                ++result.mismatches;
+                stopped = stop_on_mismatch;
+            }
+            since_checksum = 0;
+            break;
+        }
+    }
+
+    result.wall_time_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.ok = !stopped && !reader.corrupt() && result.mismatches == 0;
+    return result;
+}
+
+#endif // INPUT_JOURNAL_HPP
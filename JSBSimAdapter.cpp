@@ -0,0 +1,7 @@
+// JSBSimAdapter.cpp
+// JSBSimKinematicAdapter 的显式实例化; JSBSimModelAdapter 与 JSBSimV2Adapter 分别在
+// StandaloneJSBSimModel.cpp 与 V2/StandaloneJSBSim.cpp 中实例化
+#include "JSBSimAdapterImpl.hpp"
+
+template class JSBSimAdapter<adapter::NoTrim, adapter::KinematicFields, adapter::NedDownUnits, adapter::Engines<0>,
+                             adapter::V2Startup>;
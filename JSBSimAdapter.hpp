@@ -0,0 +1,317 @@
+// JSBSimAdapter.hpp
+#ifndef JSBSIM_ADAPTER_HPP
+#define JSBSIM_ADAPTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "JSBSimAircraftState.hpp"
+#include "JSBSimCheckpoint.hpp"
+#include "TripleBuffer.hpp"
+#include "TelemetrySchema.hpp"
+#include "PerfStats.hpp"
+
+class FleetStateSoA;
+class ModelTemplateCache;
+struct ModelLoadOptions;
+class TrimCache;
+class ControlCommandQueue;
+struct ControlFrame;
+struct JSBSimTelemetryHandles;
+struct JSBSimCheckpointNodes;
+struct JSBSimLoadedState;
+
+// JSBSim类的正向声明，避免在头文件中包含大型JSBSim头文件
+namespace JSBSim {
+    class FGFDMExec;
+}
+
+// --- 策略 ---
+// JSBSimAdapter<Policies...> 的每个特性由一个策略类在编译期选定, 未给出的取默认值。
+// 策略顺序任意, 同一类别给出多个时取第一个。
+namespace adapter {
+
+struct TrimTag {};
+struct FieldsTag {};
+struct UnitsTag {};
+struct EnginesTag {};
+struct StartupTag {};
+
+// 配平: NoTrim 时 updateTrims() 与配平开关接口编译为空
+struct NoTrim {
+    using category = TrimTag;
+    static constexpr bool enabled = false;
+};
+struct TrimSwitches { // 与 V2 StandaloneJSBSim 相同的配平开关积分
+    using category = TrimTag;
+    static constexpr bool enabled = true;
+};
+
+// 每帧提取的字段组(TelemetrySchema::Group 按位或), 未选中的组不进入每帧代码;
+// 运行时的 setTelemetrySchema() 只能在此范围内再做选择
+template<unsigned Groups>
+struct Fields {
+    using category = FieldsTag;
+    static constexpr unsigned groups = Groups;
+};
+using AllFields = Fields<TelemetrySchema::All>;
+using KinematicFields = Fields<TelemetrySchema::Position | TelemetrySchema::Velocity |
+                               TelemetrySchema::Attitude | TelemetrySchema::AngularRate>;
+
+// 坐标/单位约定, 含英尺与米的换算方式(两个原有包装类所用的常数不同)
+struct AltitudeUpUnits { // 取自 StandaloneJSBSimModel: position_ned.z = +高度, 加速度取 GetNedAccel()
+    using category = UnitsTag;
+    static constexpr bool altitude_down = false;
+    static constexpr bool accel_from_uvwdot = false;
+    static double ftToM(double ft) { return ft * (1.0 / 3.28084); }
+    static double mToFt(double m) { return m * 3.28084; }
+};
+struct NedDownUnits { // 取自 V2 StandaloneJSBSim: position_ned.z = -高度, 加速度为 Tb2l * UVWdot (米/秒^2)
+    using category = UnitsTag;
+    static constexpr bool altitude_down = true;
+    static constexpr bool accel_from_uvwdot = true;
+    static double ftToM(double ft) { return ft * oe_base::FT2M; }
+    static double mToFt(double m) { return m / oe_base::FT2M; }
+};
+
+// 启动方式: init() 设置模型目录的方式与默认调试级别, 以及 runInitialConditions() 在 RunIC 之前如何启动发动机
+struct ModelStartup { // 取自 StandaloneJSBSimModel: SGPath(根目录), 不修改调试级别; 各发动机 SetRunning(true), 油门不变
+    using category = StartupTag;
+    static constexpr int debug_level = -1;
+    static constexpr bool split_paths = false;
+    static constexpr bool full_throttle = false;
+    static constexpr bool init_running = false;
+};
+struct V2Startup { // 取自 V2 StandaloneJSBSim: UTF-8路径并分别设置模型目录, 调试级别0; 另将油门置为全开并 InitRunning(-1)
+    using category = StartupTag;
+    static constexpr int debug_level = 0;
+    static constexpr bool split_paths = true;
+    static constexpr bool full_throttle = true;
+    static constexpr bool init_running = true;
+};
+
+// 状态中报告的发动机台数: Engines<N> 固定台数(模型台数少于N时 init() 失败), Engines<0> 不读取推进数据;
+// DynamicEngines 在 init() 时按模型确定。油门等控制指令始终作用于模型的全部发动机
+template<int N>
+struct Engines {
+    static_assert(N >= 0 && N <= PropulsionArray::CAPACITY, "Engines<N>: N exceeds PropulsionArray::CAPACITY");
+    using category = EnginesTag;
+    static constexpr int count = N;
+};
+struct DynamicEngines {
+    using category = EnginesTag;
+    static constexpr int count = -1;
+};
+
+template<class Tag, class Default, class... Ps>
+struct SelectPolicy {
+    using type = Default;
+};
+template<class Tag, class Default, class P, class... Ps>
+struct SelectPolicy<Tag, Default, P, Ps...> {
+    using type = typename std::conditional<std::is_same<typename P::category, Tag>::value, P,
+                                           typename SelectPolicy<Tag, Default, Ps...>::type>::type;
+};
+
+} // namespace adapter
+
+// --- 策略化的JSBSim包装类 ---
+// StandaloneJSBSimModel 与 V2 StandaloneJSBSim 的唯一实现: 两者是本模板的别名(见各自头文件),
+// 区别只在编译期选定的配平、单位与启动方式策略。初始化、控制、状态提取以及检查点、SoA、遥测声明、多速率、
+// 指令队列、配平缓存、状态发布与计时等扩展功能都只在这里实现一次。
+// 成员函数定义在 JSBSimAdapterImpl.hpp; 下方预定义组合分别在 StandaloneJSBSimModel.cpp、V2/StandaloneJSBSim.cpp
+// 与 JSBSimAdapter.cpp 中显式实例化, 其他策略组合需在某个 .cpp 中包含 JSBSimAdapterImpl.hpp 并显式实例化。
+template<class... Policies>
+class JSBSimAdapter {
+public:
+    using Trim = typename adapter::SelectPolicy<adapter::TrimTag, adapter::NoTrim, Policies...>::type;
+    using Fields = typename adapter::SelectPolicy<adapter::FieldsTag, adapter::AllFields, Policies...>::type;
+    using Units = typename adapter::SelectPolicy<adapter::UnitsTag, adapter::AltitudeUpUnits, Policies...>::type;
+    using Engines = typename adapter::SelectPolicy<adapter::EnginesTag, adapter::DynamicEngines, Policies...>::type;
+    using Startup = typename adapter::SelectPolicy<adapter::StartupTag, adapter::V2Startup, Policies...>::type;
+
+    JSBSimAdapter();
+    ~JSBSimAdapter();
+    JSBSimAdapter(const JSBSimAdapter&) = delete;
+    JSBSimAdapter& operator=(const JSBSimAdapter&) = delete;
+
+    // --- 初始化与配置 ---
+    // debug_level < 0 时不修改JSBSim调试级别, 默认值由 Startup 策略决定
+    bool init(const std::string& jsbsim_root_dir, const std::string& aircraft_model, int debug_level = Startup::debug_level);
+    void setInitialConditions(double lat_deg, double lon_deg, double alt_m, double hdg_deg, double speed_kts);
+    bool runInitialConditions();
+    // 在 setInitialConditions() 之后调用: 初始航迹倾角与滚转角(度), 用于从另一模型的飞行状态接续
+    void setInitialFlightPath(double gamma_deg, double roll_deg);
+    // 不重新加载模型, 把执行器与本实例的运行状态恢复到 init() 刚完成时: 执行器同 ModelTemplateCache 的复用
+    // (见 JSBSimLoadedState), 另清零配平位置与开关、多速率子步缓冲和状态, 并解除指令队列(队列按仿真时间排序,
+    // 复位后仿真时间回到0)。配置(模型缓存、配平缓存与 setTrimOnInit、遥测声明、SoA绑定、内部频率、状态发布)保留。
+    // 之后照常 setInitialConditions() + runInitialConditions(); 结果不取决于此前跑过什么(见 montecarlo_determinism.cpp)
+    bool resetToLoaded();
+
+    // 关闭后 init() 不再向 std::cout 打印版本和加载信息(失败信息仍输出到 std::cerr), 也不按 debug_level 修改
+    // 进程全局的JSBSim调试级别, 用于后台加载线程; 调试级别由主线程经 ModelTemplateCache::setJSBSimDebugLevel() 统一设置
+    void setVerbose(bool verbose) { m_verbose = verbose; }
+
+    // 使用已加载模型缓存: 须在 init() 前设置; 实例销毁时执行器归还缓存供复用
+    void setModelCache(ModelTemplateCache* cache) { m_cache = cache; }
+    // 本类的加载方式(由 Startup 策略决定), 供 ModelTemplateCache::prewarm() 等预加载时使用
+    static ModelLoadOptions cacheLoadOptions(int debug_level = Startup::debug_level);
+
+    // 使用配平缓存: runInitialConditions() 按 (高度, 速度, 重量, 构型) 查缓存,
+    // 命中或可插值时直接以缓存解初始化, 不再迭代配平; 未命中时配平一次并写回缓存。地面出生不配平
+    void setTrimCache(TrimCache* cache) { m_trimCache = cache; }
+    // 开启后未设置配平缓存时 runInitialConditions() 同样在空中执行一次完整配平(tFull), 保持初始条件的航迹倾角;
+    // 初始条件带滚转角时改为协调转弯配平(tTurn), 保持滚转角且不经配平缓存
+    void setTrimOnInit(bool trim) { m_trimOnInit = trim; }
+
+    // --- 核心更新 ---
+    void update(double dt);
+
+    // 多速率模式: 以固定内部频率积分(如120/240Hz), 与 update(dt) 的调用频率解耦。
+    // 每次 update 按累计时间执行若干个内部子步, getState() 为插值到主机时刻的状态; 传入 0 恢复每帧一次 Run()。
+    // 配平按子步积分, 每个子步先施加到期指令(含配平开关)再积分配平, 与单速率的一帧顺序相同
+    void setInternalRate(double hz);
+
+    // --- 控制指令接口 ---
+    // 油门指令作用于模型的全部发动机, 包括状态中未报告的部分
+    void setControlStickRoll(double norm_val);      // -1.0 to 1.0
+    void setControlStickPitch(double norm_val);     // -1.0 to 1.0
+    void setRudderPedal(double norm_val);           // -1.0 to 1.0
+    void setThrottle(int engine_idx, double norm_val); // 0.0 to 1.0
+    void setThrottles(double norm_val);
+    void setGearHandle(bool down);
+    void setBrakes(double left, double right);
+    void setSpeedBrakes(double norm_val);           // -1.0 (retract), 0.0 (hold), 1.0 (extend)
+    void setTrimSwitchRoll(double val);             // -1.0 (left), 0.0 (hold), 1.0 (right); 仅 TrimSwitches 生效
+    void setTrimSwitchPitch(double val);            // -1.0 (down), 0.0 (hold), 1.0 (up); 仅 TrimSwitches 生效
+
+    // --- 批量控制输入 ---
+    // 一次取得FCS并写入帧中所有有效字段; NoTrim 时 TrimRoll/TrimPitch 被忽略
+    void applyControls(const ControlFrame& controls);
+    // 带时间戳的指令队列: 每个积分步(多速率模式下为每个子步)开始前应用到期的指令; 传入 nullptr 解除
+    void setCommandQueue(ControlCommandQueue* queue) { m_commands = queue; }
+
+    // --- 获取状态 ---
+    const JSBSimAircraftState& getState() const { return m_state; }
+
+    // --- 检查点 ---
+    // 保存/恢复完整的FDM状态(积分状态、FCS与作动器、发动机与油量、配平), 用于快速回退和分支推演;
+    // 检查点只能恢复到同一机型的实例上。保存不改变之后的轨迹; 积分器历史与 FCS 滤波器/作动器的内部历史不在检查点中,
+    // 恢复时重新开始, 因此同一检查点多次恢复的轨迹彼此逐位一致, 与保存后直接推进的轨迹只在容差内一致
+    // (见 JSBSimCheckpointNodes.hpp)
+    bool saveCheckpoint(JSBSimCheckpoint& checkpoint);
+    bool restoreCheckpoint(const JSBSimCheckpoint& checkpoint);
+
+    // --- 跨线程状态发布 ---
+    // 开启后每帧结束时将一致的状态快照发布到三缓冲, 不阻塞仿真线程;
+    // 另一个线程(显示、网络、传感器)调用 acquireLatestState() 获取最新的完整帧。
+    // 仅支持一个读线程, 须在读线程启动前开启; 从未开启时返回 getState()(只能在仿真线程调用)。
+    // 关闭只停止发布, 三缓冲保留到包装类析构, 读线程可继续读到最后一帧; 读线程须在包装类析构前停止。
+    void enableStatePublication(bool enable);
+    const JSBSimAircraftState& acquireLatestState();
+
+    // --- 遥测声明 ---
+    // 声明每帧需要的输出组和额外属性路径; init() 时解析为句柄表, 之后每帧只拷贝选中的值。
+    // 输出组与 Fields 策略取交集
+    void setTelemetrySchema(const TelemetrySchema& schema);
+    const std::vector<double>& getTelemetryValues() const { return m_telemetryValues; } // 额外属性, 按声明顺序
+
+    // --- 机群SoA输出 ---
+    // 绑定后每帧状态直接写入 soa 的 slot 槽位, getState() 不再逐帧刷新; 传入 nullptr 解除绑定
+    void bindStateSlot(FleetStateSoA* soa, std::size_t slot);
+
+    // --- 热路径计时 ---
+    // 包装类的显式实例化(StandaloneJSBSimModel.cpp 等)以 JSBSIM_ENABLE_PERF_STATS 编译时统计 update() 各阶段耗时、
+    // 调用次数与 Run() 失败次数; 未启用时返回 enabled == false 的空统计
+    PerfStats getPerfStats() const { return m_perf.snapshot(); }
+    void resetPerfStats() { m_perf.reset(); }
+
+private:
+    static constexpr double LEVEL_BANK_RAD = 1e-3; // 初始滚转角超过此值时按转弯配平
+    static constexpr bool hasField(unsigned group) { return (Fields::groups & group) != 0; }
+    // 状态中报告的发动机台数
+    int stateEngines() const { return Engines::count >= 0 ? Engines::count : m_state.num_engines; }
+
+    void resolveTelemetry();
+    void updateStateFromJSBSim(); // 从JSBSim取回数据
+    void updateSoASlotFromJSBSim();
+    void extractState(JSBSimAircraftState& s);
+    void updateSubSteps(double dt);
+    void resyncSubSteps();
+    bool runFrame();
+    void applyQueuedCommands(double step_dt);
+    void publishState();
+    void releaseToCache();
+    void trimInitialConditions();
+    void updateTrims(double dt);
+
+    std::unique_ptr<JSBSim::FGFDMExec> fdmex;
+    JSBSimAircraftState m_state;
+    int m_modelEngines = 0; // 模型实际的发动机台数, 可多于状态中报告的 m_state.num_engines
+
+    TelemetrySchema m_schema;
+    std::unique_ptr<JSBSimTelemetryHandles> m_telemetry;
+    std::vector<double> m_telemetryValues;
+
+    std::unique_ptr<JSBSimCheckpointNodes> m_checkpointNodes;
+    std::unique_ptr<JSBSimLoadedState> m_loaded; // init() 完成时的执行器状态, 供 resetToLoaded()
+
+    bool m_verbose = true;
+
+    ModelTemplateCache* m_cache = nullptr;
+    std::string m_cacheRoot;
+    std::string m_cacheModel;
+
+    TrimCache* m_trimCache = nullptr;
+    bool m_trimOnInit = false;
+    std::string m_aircraftModel;
+
+    std::unique_ptr<TripleBuffer<JSBSimAircraftState>> m_published; // 第一次开启时创建, 之后不再释放
+    bool m_publishing = false;
+
+    ControlCommandQueue* m_commands = nullptr;
+
+    PerfCounters m_perf;
+
+    FleetStateSoA* m_soa = nullptr;
+    std::size_t m_soaSlot = 0;
+
+    // 多速率子步: FDM时间超前主机时间 m_stepLead, m_stepPrev/m_stepCurr 为上一帧与本帧子步结束时的状态,
+    // 两者相隔 m_stepSpan 秒
+    double m_internalDt = 0.0;
+    double m_stepLead = 0.0;
+    double m_stepSpan = 0.0;
+    JSBSimAircraftState m_stepPrev;
+    JSBSimAircraftState m_stepCurr;
+
+    // 配平相关变量(仅 TrimSwitches 使用)
+    double m_pitchTrimPos{};
+    double m_pitchTrimRate{0.1};
+    double m_pitchTrimSw{};
+    double m_rollTrimPos{};
+    double m_rollTrimRate{0.1};
+    double m_rollTrimSw{};
+};
+
+// --- 预定义组合 ---
+// StandaloneJSBSimModel: 无配平开关, position_ned.z = +高度
+using JSBSimModelAdapter = JSBSimAdapter<adapter::NoTrim, adapter::AllFields, adapter::AltitudeUpUnits, adapter::DynamicEngines,
+                                         adapter::ModelStartup>;
+// V2 StandaloneJSBSim: 配平开关积分, position_ned.z = -高度
+using JSBSimV2Adapter = JSBSimAdapter<adapter::TrimSwitches, adapter::AllFields, adapter::NedDownUnits, adapter::DynamicEngines,
+                                      adapter::V2Startup>;
+// 大规模机群用: 只提取位置/速度/姿态/角速度, 不积分配平, 不读取推进数据
+using JSBSimKinematicAdapter = JSBSimAdapter<adapter::NoTrim, adapter::KinematicFields, adapter::NedDownUnits, adapter::Engines<0>,
+                                             adapter::V2Startup>;
+
+extern template class JSBSimAdapter<adapter::NoTrim, adapter::AllFields, adapter::AltitudeUpUnits, adapter::DynamicEngines,
+                                    adapter::ModelStartup>;
+extern template class JSBSimAdapter<adapter::TrimSwitches, adapter::AllFields, adapter::NedDownUnits, adapter::DynamicEngines,
+                                    adapter::V2Startup>;
+extern template class JSBSimAdapter<adapter::NoTrim, adapter::KinematicFields, adapter::NedDownUnits, adapter::Engines<0>,
+                                    adapter::V2Startup>;
+
+#endif // JSBSIM_ADAPTER_HPP
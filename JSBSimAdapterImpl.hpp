@@ -0,0 +1,697 @@
+// JSBSimAdapterImpl.hpp
+// JSBSimAdapter 的成员函数定义; 仅供需要显式实例化的实现文件包含: 需要完整的JSBSim头文件
+#ifndef JSBSIM_ADAPTER_IMPL_HPP
+#define JSBSIM_ADAPTER_IMPL_HPP
+
+#include "JSBSimAdapter.hpp"
+#include "FleetStateSoA.hpp"
+#include "ModelTemplateCache.hpp"
+#include "JSBSimTelemetryHandles.hpp"
+#include "JSBSimCheckpointNodes.hpp"
+#include "JSBSimLoadedState.hpp"
+#include "StateInterpolation.hpp"
+#include "ControlFrame.hpp"
+#include "TrimCache.hpp"
+
+// 引入所有需要的JSBSim头文件
+#include <JSBSim/FGFDMExec.h>
+#include <JSBSim/models/FGAuxiliary.h>
+#include <JSBSim/models/FGPropulsion.h>
+#include <JSBSim/models/FGFCS.h>
+#include <JSBSim/models/FGGroundReactions.h>
+#include <JSBSim/models/FGPropagate.h>
+#include <JSBSim/models/FGAccelerations.h>
+#include <JSBSim/models/FGMassBalance.h>
+#include <JSBSim/initialization/FGInitialCondition.h>
+#include <JSBSim/initialization/FGTrim.h>
+#include <JSBSim/models/propulsion/FGEngine.h>
+#include <JSBSim/models/propulsion/FGThruster.h>
+#include <JSBSim/simgear/misc/sg_path.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+template<class... Policies>
+JSBSimAdapter<Policies...>::JSBSimAdapter() = default;
+
+template<class... Policies>
+JSBSimAdapter<Policies...>::~JSBSimAdapter() {
+    releaseToCache();
+}
+
+template<class... Policies>
+bool JSBSimAdapter<Policies...>::init(const std::string& jsbsim_root_dir, const std::string& aircraft_model, int debug_level) {
+    releaseToCache();
+    if (!m_verbose) debug_level = -1; // 调试级别为进程全局, 后台加载时不修改
+    m_aircraftModel = aircraft_model;
+    if (m_cache) {
+        // 从缓存取得已加载好的执行器, 跳过读盘和XML解析
+        fdmex.reset(m_cache->acquire(jsbsim_root_dir, aircraft_model, cacheLoadOptions(debug_level)).release());
+        if (!fdmex) return false;
+        if (debug_level >= 0) fdmex->SetDebugLevel(debug_level);
+        m_cacheRoot = jsbsim_root_dir;
+        m_cacheModel = aircraft_model;
+    } else {
+        fdmex = std::make_unique<JSBSim::FGFDMExec>();
+        if (!fdmex) return false;
+
+        if (m_verbose) std::cout << "Using JSBSim version " << fdmex->GetVersion() << std::endl;
+
+        if constexpr (Startup::split_paths) {
+            // 使用SGPath来处理UTF-8路径，这与源文件逻辑保持一致
+            fdmex->SetRootDir(SGPath::fromString(jsbsim_root_dir));
+            fdmex->SetAircraftPath(SGPath::from_string(jsbsim_root_dir + "/aircraft"));
+            fdmex->SetEnginePath(SGPath::from_string(jsbsim_root_dir + "/engine"));
+            fdmex->SetSystemsPath(SGPath::from_string(jsbsim_root_dir + "/systems"));
+        } else {
+            fdmex->SetRootDir(SGPath(jsbsim_root_dir));
+        }
+        if (debug_level >= 0) fdmex->SetDebugLevel(debug_level);
+
+        if (m_verbose) std::cout << "Loading aircraft model: " << aircraft_model << std::endl;
+        if (!fdmex->LoadModel(aircraft_model)) {
+            std::cerr << "Failed to load JSBSim model!" << std::endl;
+            fdmex.reset();
+            return false;
+        }
+    }
+
+    // 控制指令作用于模型的全部发动机, 状态快照只报告 Engines 策略给定的台数, 且最多 CAPACITY 台
+    m_modelEngines = static_cast<int>(fdmex->GetPropulsion()->GetNumEngines());
+    if (Engines::count > m_modelEngines) {
+        std::cerr << "Aircraft model has " << m_modelEngines << " engines, adapter expects " << Engines::count << std::endl;
+        releaseToCache();
+        return false;
+    }
+    m_state.num_engines = Engines::count >= 0 ? Engines::count : m_modelEngines;
+    if (m_state.num_engines > PropulsionArray::CAPACITY) {
+        std::cerr << "Aircraft model has " << m_modelEngines << " engines, state reports the first "
+                  << PropulsionArray::CAPACITY << std::endl;
+        m_state.num_engines = PropulsionArray::CAPACITY;
+    }
+    m_state.propulsion.resize(m_state.num_engines);
+
+    // 按遥测声明解析句柄表
+    m_telemetry = std::make_unique<JSBSimTelemetryHandles>();
+    resolveTelemetry();
+
+    m_loaded = std::make_unique<JSBSimLoadedState>();
+    m_loaded->capture(*fdmex);
+    return true;
+}
+
+template<class... Policies>
+bool JSBSimAdapter<Policies...>::resetToLoaded() {
+    if (!fdmex || !m_loaded) return false;
+    m_loaded->restore(*fdmex);
+
+    m_commands = nullptr;
+    m_pitchTrimPos = m_pitchTrimSw = 0.0;
+    m_rollTrimPos = m_rollTrimSw = 0.0;
+    m_pitchTrimRate = m_rollTrimRate = 0.1;
+
+    const int engines = m_state.num_engines;
+    m_state = JSBSimAircraftState{};
+    m_state.num_engines = engines;
+    m_state.propulsion.resize(engines);
+    m_stepPrev = m_stepCurr = m_state;
+    m_stepLead = 0.0;
+    m_stepSpan = m_internalDt;
+    return true;
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::resolveTelemetry() {
+    TelemetrySchema schema = m_schema;
+    schema.groups &= Fields::groups;
+    m_telemetry->resolve(*fdmex, schema, m_telemetryValues);
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::setTelemetrySchema(const TelemetrySchema& schema) {
+    m_schema = schema;
+    if (fdmex && m_telemetry) resolveTelemetry();
+}
+
+// 与非缓存路径相同, 按 Startup 策略设置模型目录; 同一启动方式的组合共用缓存池
+template<class... Policies>
+ModelLoadOptions JSBSimAdapter<Policies...>::cacheLoadOptions(int debug_level) {
+    ModelLoadOptions options;
+    options.split_paths = Startup::split_paths;
+    options.debug_level = debug_level;
+    return options;
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::releaseToCache() {
+    if (fdmex && m_cache && !m_cacheModel.empty()) {
+        m_cache->release(m_cacheRoot, m_cacheModel, ModelTemplateCache::ExecPtr(fdmex.release()), cacheLoadOptions());
+    }
+    fdmex.reset();
+    m_telemetry.reset();
+    m_checkpointNodes.reset();
+    m_loaded.reset();
+    m_cacheRoot.clear();
+    m_cacheModel.clear();
+}
+
+// 设置了配平缓存时以缓存的配平解(攻角/侧滑角/滚转角 + 舵面与油门指令)作为初始条件重新 RunIC, 省去配平迭代;
+// 未设置缓存或缓存中没有可用的解时执行一次完整配平, 有缓存时把结果写回。
+// 初始条件带滚转角时(如从质点模型接续的盘旋)以协调转弯配平(tTurn)保持该滚转角: 完整配平(tFull)以滚转角消除侧向加速度,
+// 会把飞机配平到机翼水平; 此时也不经缓存, 因为命中时写回的是缓存解的滚转角, 与初始条件可相差半格
+template<class... Policies>
+void JSBSimAdapter<Policies...>::trimInitialConditions() {
+    if (fdmex->GetGroundReactions()->GetWOW()) return;
+
+    auto ic = fdmex->GetIC();
+    auto fcs = fdmex->GetFCS();
+    auto propulsion = fdmex->GetPropulsion();
+
+    const int engines = static_cast<int>(propulsion->GetNumEngines());
+    const bool banked = std::abs(ic->GetPhiRadIC()) > LEVEL_BANK_RAD;
+    TrimSolution solution;
+    TrimConditions conditions;
+    if (m_trimCache && !banked) {
+        conditions.alt_m = Units::ftToM(ic->GetAltitudeASLFtIC());
+        conditions.speed_kts = ic->GetVtrueKtsIC();
+        conditions.weight_lbs = fdmex->GetMassBalance()->GetWeight();
+        conditions.gamma_rad = ic->GetFlightPathAngleRadIC();
+        conditions.phi_rad = ic->GetPhiRadIC();
+        conditions.config = TrimCache::makeConfig(fcs->GetGearCmd() > 0.5, fcs->GetDfCmd());
+
+        if (m_trimCache->lookup(m_aircraftModel, conditions, solution) &&
+            solution.throttle_cmd.size() == static_cast<std::size_t>(engines)) {
+            ic->SetAlphaRadIC(solution.alpha_rad);
+            ic->SetBetaRadIC(solution.beta_rad);
+            ic->SetPhiRadIC(solution.phi_rad);
+            fcs->SetDeCmd(solution.elevator_cmd);
+            fcs->SetDaCmd(solution.aileron_cmd);
+            fcs->SetDrCmd(solution.rudder_cmd);
+            fcs->SetPitchTrimCmd(solution.pitch_trim_cmd);
+            for (int i = 0; i < engines; ++i) fcs->SetThrottleCmd(i, solution.throttle_cmd[i]);
+            if constexpr (Trim::enabled) m_pitchTrimPos = solution.pitch_trim_cmd; // updateTrims() 每帧写回俯仰配平
+            fdmex->RunIC();
+            return;
+        }
+    }
+
+    try {
+        fdmex->DoTrim(banked ? JSBSim::tTurn : JSBSim::tFull);
+    } catch (...) {
+        std::cerr << "Trim failed, starting untrimmed." << std::endl;
+        fdmex->RunIC();
+        return;
+    }
+
+    if constexpr (Trim::enabled) m_pitchTrimPos = fcs->GetPitchTrimCmd(); // updateTrims() 每帧写回俯仰配平
+    if (!m_trimCache || banked) return;
+    auto aux = fdmex->GetAuxiliary();
+    solution.alpha_rad = aux->Getalpha();
+    solution.beta_rad = aux->Getbeta();
+    solution.phi_rad = fdmex->GetPropagate()->GetEuler(JSBSim::FGJSBBase::ePhi);
+    solution.elevator_cmd = fcs->GetDeCmd();
+    solution.aileron_cmd = fcs->GetDaCmd();
+    solution.rudder_cmd = fcs->GetDrCmd();
+    solution.pitch_trim_cmd = fcs->GetPitchTrimCmd();
+    solution.throttle_cmd.resize(engines);
+    for (int i = 0; i < engines; ++i) solution.throttle_cmd[i] = fcs->GetThrottleCmd(i);
+    m_trimCache->store(m_aircraftModel, conditions, solution);
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::setInitialConditions(double lat_deg, double lon_deg, double alt_m, double hdg_deg, double speed_kts) {
+    if (!fdmex) return;
+    auto ic = fdmex->GetIC();
+    ic->SetLatitudeDegIC(lat_deg);
+    ic->SetLongitudeDegIC(lon_deg);
+    ic->SetAltitudeASLFtIC(Units::mToFt(alt_m));
+    ic->SetPsiDegIC(hdg_deg);
+    ic->SetVtrueKtsIC(speed_kts);
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::setInitialFlightPath(double gamma_deg, double roll_deg) {
+    if (!fdmex) return;
+    auto ic = fdmex->GetIC();
+    ic->SetFlightPathAngleDegIC(gamma_deg);
+    ic->SetPhiDegIC(roll_deg);
+}
+
+template<class... Policies>
+bool JSBSimAdapter<Policies...>::runInitialConditions() {
+    if (!fdmex) return false;
+
+    // 启动引擎, 方式由 Startup 策略决定
+    auto propulsion = fdmex->GetPropulsion();
+    auto fcs = fdmex->GetFCS();
+    for (int i = 0; i < m_modelEngines; ++i) {
+        propulsion->GetEngine(i)->SetRunning(true);
+        if constexpr (Startup::full_throttle) fcs->SetThrottleCmd(i, 1.0); // Set initial throttle to full
+    }
+    if constexpr (Startup::init_running) propulsion->InitRunning(-1);
+
+    const bool result = fdmex->RunIC();
+    if (result) {
+        if (m_trimCache || m_trimOnInit) trimInitialConditions();
+        updateStateFromJSBSim(); // 运行IC后立即更新一次状态
+        resyncSubSteps();
+        publishState();
+    }
+    return result;
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::update(double dt) {
+    if (!fdmex) return;
+    JSBSIM_PERF_SCOPE(m_perf, PerfPhase::Update);
+    if (m_internalDt > 0.0) {
+        updateSubSteps(dt); // 配平随子步积分
+    } else {
+        applyQueuedCommands(dt);
+        updateTrims(dt);
+        fdmex->Setdt(dt);
+        runFrame();
+        updateStateFromJSBSim();
+    }
+    publishState();
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::setInternalRate(double hz) {
+    m_internalDt = hz > 0.0 ? 1.0 / hz : 0.0;
+    m_stepSpan = m_internalDt;
+    if (fdmex && m_telemetry) resyncSubSteps();
+}
+
+// FDM按固定步长超前运行, 主机时刻总落在上一帧与本帧子步结束时刻之间。
+// 每个子步与单速率的一帧顺序相同: 先施加到期指令(含配平开关), 再积分配平, 然后 Run();
+// 各子步之间不取状态, 只在最后一个子步之后取一次, 与上一帧的结果插值到主机时刻
+template<class... Policies>
+void JSBSimAdapter<Policies...>::updateSubSteps(double dt) {
+    int steps = 0;
+    m_stepLead -= dt;
+    while (m_stepLead < -1e-9 * m_internalDt) {
+        m_stepLead += m_internalDt;
+        ++steps;
+    }
+
+    if (steps > 0) {
+        fdmex->Setdt(m_internalDt);
+        for (int i = 0; i < steps; ++i) {
+            applyQueuedCommands(m_internalDt);
+            updateTrims(m_internalDt);
+            runFrame();
+        }
+        std::swap(m_stepPrev, m_stepCurr);
+        extractState(m_stepCurr);
+        m_stepSpan = steps * m_internalDt;
+    }
+
+    const double t = std::max(0.0, std::min(1.0, 1.0 - m_stepLead / m_stepSpan));
+    state_interp::interpolate(m_stepPrev, m_stepCurr, t, m_state);
+    if (m_soa) m_soa->store(m_soaSlot, m_state);
+}
+
+template<class... Policies>
+bool JSBSimAdapter<Policies...>::runFrame() {
+    JSBSIM_PERF_SCOPE(m_perf, PerfPhase::Run);
+    const bool ok = fdmex->Run();
+    if (!ok) {
+        JSBSIM_PERF_RUN_FAILED(m_perf);
+        std::cerr << "JSBSim::Run() failed!" << std::endl;
+    }
+    return ok;
+}
+
+// 初始条件或检查点生效后, 以当前FDM状态重建子步缓冲
+template<class... Policies>
+void JSBSimAdapter<Policies...>::resyncSubSteps() {
+    if (m_internalDt <= 0.0) return;
+    extractState(m_stepCurr);
+    m_stepPrev = m_stepCurr;
+    m_stepLead = 0.0;
+    m_stepSpan = m_internalDt;
+}
+
+template<class... Policies>
+bool JSBSimAdapter<Policies...>::saveCheckpoint(JSBSimCheckpoint& checkpoint) {
+    if (!fdmex) return false;
+    if (!m_checkpointNodes) m_checkpointNodes = std::make_unique<JSBSimCheckpointNodes>();
+    m_checkpointNodes->capture(*fdmex, checkpoint);
+    if constexpr (Trim::enabled) {
+        checkpoint.pitch_trim_pos = m_pitchTrimPos;
+        checkpoint.pitch_trim_rate = m_pitchTrimRate;
+        checkpoint.pitch_trim_sw = m_pitchTrimSw;
+        checkpoint.roll_trim_pos = m_rollTrimPos;
+        checkpoint.roll_trim_rate = m_rollTrimRate;
+        checkpoint.roll_trim_sw = m_rollTrimSw;
+    }
+    return true;
+}
+
+template<class... Policies>
+bool JSBSimAdapter<Policies...>::restoreCheckpoint(const JSBSimCheckpoint& checkpoint) {
+    if (!fdmex) return false;
+    if (!m_checkpointNodes) m_checkpointNodes = std::make_unique<JSBSimCheckpointNodes>();
+    if (!m_checkpointNodes->apply(*fdmex, checkpoint)) {
+        std::cerr << "Checkpoint does not match this aircraft model!" << std::endl;
+        return false;
+    }
+    if constexpr (Trim::enabled) {
+        m_pitchTrimPos = checkpoint.pitch_trim_pos;
+        m_pitchTrimRate = checkpoint.pitch_trim_rate;
+        m_pitchTrimSw = checkpoint.pitch_trim_sw;
+        m_rollTrimPos = checkpoint.roll_trim_pos;
+        m_rollTrimRate = checkpoint.roll_trim_rate;
+        m_rollTrimSw = checkpoint.roll_trim_sw;
+    }
+    updateStateFromJSBSim();
+    resyncSubSteps();
+    publishState();
+    return true;
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::enableStatePublication(bool enable) {
+    // 关闭时不释放三缓冲: 读线程可能仍持有 acquire() 返回的槽位
+    if (enable && !m_published) m_published = std::make_unique<TripleBuffer<JSBSimAircraftState>>();
+    m_publishing = enable;
+    publishState();
+}
+
+template<class... Policies>
+const JSBSimAircraftState& JSBSimAdapter<Policies...>::acquireLatestState() {
+    return m_published ? m_published->acquire() : m_state;
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::publishState() {
+    if (!m_publishing) return;
+    JSBSIM_PERF_SCOPE(m_perf, PerfPhase::Publish);
+    JSBSimAircraftState& out = m_published->writeBuffer();
+    if (m_soa) m_soa->load(m_soaSlot, out);
+    else out = m_state;
+    m_published->publish();
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::bindStateSlot(FleetStateSoA* soa, std::size_t slot) {
+    m_soa = soa;
+    m_soaSlot = slot;
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::updateStateFromJSBSim() {
+    if (!fdmex || !m_telemetry) return;
+    if (m_soa) {
+        updateSoASlotFromJSBSim();
+        return;
+    }
+    extractState(m_state);
+}
+
+// Fields 策略未选中的组在编译期为假, 对应分支不进入每帧代码; 选中的组再按运行时的遥测声明跳过
+template<class... Policies>
+void JSBSimAdapter<Policies...>::extractState(JSBSimAircraftState& s) {
+    JSBSIM_PERF_SCOPE(m_perf, PerfPhase::StateExtraction);
+    const JSBSimTelemetryHandles& h = *m_telemetry;
+    if (s.num_engines != m_state.num_engines) {
+        s.num_engines = m_state.num_engines;
+        s.propulsion.resize(s.num_engines);
+    }
+
+    // --- 运动学 ---
+    if (hasField(TelemetrySchema::Position) && h.has(TelemetrySchema::Position)) {
+        const double alt_m = h.prop->GetAltitudeASLmeters();
+        s.position_ned.set(h.prop->GetLocation().GetLatitudeDeg(), h.prop->GetLocation().GetLongitudeDeg(),
+                           Units::altitude_down ? -alt_m : alt_m);
+        s.altitude_sl_m = alt_m;
+    }
+    if (hasField(TelemetrySchema::Velocity) && h.has(TelemetrySchema::Velocity)) {
+        s.velocity_ned.set(Units::ftToM(h.prop->GetVel(JSBSim::FGJSBBase::eNorth)), Units::ftToM(h.prop->GetVel(JSBSim::FGJSBBase::eEast)),
+                           Units::ftToM(h.prop->GetVel(JSBSim::FGJSBBase::eDown)));
+    }
+    if (hasField(TelemetrySchema::Acceleration) && h.has(TelemetrySchema::Acceleration)) {
+        if constexpr (Units::accel_from_uvwdot) {
+            double n = 0.0, e = 0.0, d = 0.0;
+            h.localAccelFromUVWdot(n, e, d);
+            s.accel_ned.set(Units::ftToM(n), Units::ftToM(e), Units::ftToM(d));
+        } else {
+            s.accel_ned.set(h.accel->GetNedAccel(1), h.accel->GetNedAccel(2), h.accel->GetNedAccel(3));
+        }
+    }
+
+    // --- 姿态 ---
+    if (hasField(TelemetrySchema::Attitude) && h.has(TelemetrySchema::Attitude)) {
+        s.roll_rad = h.prop->GetEuler(JSBSim::FGJSBBase::ePhi);
+        s.pitch_rad = h.prop->GetEuler(JSBSim::FGJSBBase::eTht);
+        s.yaw_rad = h.prop->GetEuler(JSBSim::FGJSBBase::ePsi);
+    }
+    if (hasField(TelemetrySchema::AngularRate) && h.has(TelemetrySchema::AngularRate)) {
+        s.ang_vel_rps.set(h.prop->GetPQR(JSBSim::FGJSBBase::eP), h.prop->GetPQR(JSBSim::FGJSBBase::eQ), h.prop->GetPQR(JSBSim::FGJSBBase::eR));
+    }
+
+    // --- 空气动力学 ---
+    if (hasField(TelemetrySchema::Aero) && h.has(TelemetrySchema::Aero)) {
+        s.g_load = h.aux->GetNlf();
+        s.mach = h.aux->GetMach();
+        s.alpha_rad = h.aux->Getalpha();
+        s.beta_rad = h.aux->Getbeta();
+        s.flight_path_rad = h.aux->GetGamma();
+        s.calibrated_airspeed_kts = h.aux->GetVcalibratedKTS();
+    }
+
+    // --- 系统 ---
+    if (hasField(TelemetrySchema::Systems) && h.has(TelemetrySchema::Systems)) {
+        s.total_weight_lbs = h.mass->GetWeight();
+        s.fuel_weight_lbs = h.propulsion->GetFuelWt();
+        s.on_ground = h.ground->GetWOW();
+    }
+
+    // --- 发动机 ---
+    if (hasField(TelemetrySchema::Propulsion) && Engines::count != 0 && h.has(TelemetrySchema::Propulsion)) {
+        const int engines = stateEngines();
+        for (int i = 0; i < engines; ++i) {
+            auto engine = h.propulsion->GetEngine(i);
+            s.propulsion[i].thrust_lbf = engine->GetThruster()->GetThrust();
+            s.propulsion[i].rpm = engine->getRPM();
+            s.propulsion[i].fuel_flow_pph = engine->getFuelFlow_pph();
+            const double tmax = engine->GetThrottleMax();
+            const double tmin = engine->GetThrottleMin();
+            if (tmax > tmin) {
+                s.propulsion[i].pla_pct = (h.fcs->GetThrottlePos(i) - tmin) / (tmax - tmin) * 100.0;
+            }
+        }
+    }
+
+    // --- 额外属性 ---
+    h.readProperties(m_telemetryValues);
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::updateSoASlotFromJSBSim() {
+    JSBSIM_PERF_SCOPE(m_perf, PerfPhase::StateExtraction);
+    const JSBSimTelemetryHandles& h = *m_telemetry;
+
+    FleetStateSoA& soa = *m_soa;
+    const std::size_t i = m_soaSlot;
+
+    // --- 运动学 ---
+    if (hasField(TelemetrySchema::Position) && h.has(TelemetrySchema::Position)) {
+        const double alt_m = h.prop->GetAltitudeASLmeters();
+        soa.position_x[i] = h.prop->GetLocation().GetLatitudeDeg();
+        soa.position_y[i] = h.prop->GetLocation().GetLongitudeDeg();
+        soa.position_z[i] = Units::altitude_down ? -alt_m : alt_m;
+        soa.altitude_sl_m[i] = alt_m;
+    }
+    if (hasField(TelemetrySchema::Velocity) && h.has(TelemetrySchema::Velocity)) {
+        soa.velocity_n[i] = Units::ftToM(h.prop->GetVel(JSBSim::FGJSBBase::eNorth));
+        soa.velocity_e[i] = Units::ftToM(h.prop->GetVel(JSBSim::FGJSBBase::eEast));
+        soa.velocity_d[i] = Units::ftToM(h.prop->GetVel(JSBSim::FGJSBBase::eDown));
+    }
+    if (hasField(TelemetrySchema::Acceleration) && h.has(TelemetrySchema::Acceleration)) {
+        if constexpr (Units::accel_from_uvwdot) {
+            double n = 0.0, e = 0.0, d = 0.0;
+            h.localAccelFromUVWdot(n, e, d);
+            soa.accel_n[i] = Units::ftToM(n);
+            soa.accel_e[i] = Units::ftToM(e);
+            soa.accel_d[i] = Units::ftToM(d);
+        } else {
+            soa.accel_n[i] = h.accel->GetNedAccel(1);
+            soa.accel_e[i] = h.accel->GetNedAccel(2);
+            soa.accel_d[i] = h.accel->GetNedAccel(3);
+        }
+    }
+
+    // --- 姿态 ---
+    if (hasField(TelemetrySchema::Attitude) && h.has(TelemetrySchema::Attitude)) {
+        soa.roll_rad[i] = h.prop->GetEuler(JSBSim::FGJSBBase::ePhi);
+        soa.pitch_rad[i] = h.prop->GetEuler(JSBSim::FGJSBBase::eTht);
+        soa.yaw_rad[i] = h.prop->GetEuler(JSBSim::FGJSBBase::ePsi);
+    }
+    if (hasField(TelemetrySchema::AngularRate) && h.has(TelemetrySchema::AngularRate)) {
+        soa.ang_vel_p[i] = h.prop->GetPQR(JSBSim::FGJSBBase::eP);
+        soa.ang_vel_q[i] = h.prop->GetPQR(JSBSim::FGJSBBase::eQ);
+        soa.ang_vel_r[i] = h.prop->GetPQR(JSBSim::FGJSBBase::eR);
+    }
+
+    // --- 空气动力学 ---
+    if (hasField(TelemetrySchema::Aero) && h.has(TelemetrySchema::Aero)) {
+        soa.g_load[i] = h.aux->GetNlf();
+        soa.mach[i] = h.aux->GetMach();
+        soa.alpha_rad[i] = h.aux->Getalpha();
+        soa.beta_rad[i] = h.aux->Getbeta();
+        soa.flight_path_rad[i] = h.aux->GetGamma();
+        soa.calibrated_airspeed_kts[i] = h.aux->GetVcalibratedKTS();
+    }
+
+    // --- 系统 ---
+    if (hasField(TelemetrySchema::Systems) && h.has(TelemetrySchema::Systems)) {
+        soa.total_weight_lbs[i] = h.mass->GetWeight();
+        soa.fuel_weight_lbs[i] = h.propulsion->GetFuelWt();
+        soa.on_ground[i] = h.ground->GetWOW() ? 1 : 0;
+    }
+
+    // --- 发动机 ---
+    if (hasField(TelemetrySchema::Propulsion) && Engines::count != 0 && h.has(TelemetrySchema::Propulsion)) {
+        const int engines = std::min(soa.num_engines[i], stateEngines());
+        const std::size_t base = static_cast<std::size_t>(soa.engine_offset[i]);
+        for (int e = 0; e < engines; ++e) {
+            auto engine = h.propulsion->GetEngine(e);
+            soa.engine_thrust_lbf[base + e] = engine->GetThruster()->GetThrust();
+            soa.engine_rpm[base + e] = engine->getRPM();
+            soa.engine_fuel_flow_pph[base + e] = engine->getFuelFlow_pph();
+            const double tmax = engine->GetThrottleMax();
+            const double tmin = engine->GetThrottleMin();
+            if (tmax > tmin) {
+                soa.engine_pla_pct[base + e] = (h.fcs->GetThrottlePos(e) - tmin) / (tmax - tmin) * 100.0;
+            }
+        }
+    }
+
+    // --- 额外属性 ---
+    h.readProperties(m_telemetryValues);
+}
+
+// --- 控制指令实现 ---
+// NoTrim 时编译为空
+template<class... Policies>
+void JSBSimAdapter<Policies...>::updateTrims(double dt) {
+    if constexpr (Trim::enabled) {
+        JSBSIM_PERF_SCOPE(m_perf, PerfPhase::Trims);
+        auto fcs = fdmex->GetFCS();
+
+        m_pitchTrimPos += m_pitchTrimRate * m_pitchTrimSw * dt;
+        m_pitchTrimPos = std::max(-1.0, std::min(1.0, m_pitchTrimPos));
+        fcs->SetPitchTrimCmd(m_pitchTrimPos);
+
+        m_rollTrimPos += m_rollTrimRate * m_rollTrimSw * dt;
+        m_rollTrimPos = std::max(-1.0, std::min(1.0, m_rollTrimPos));
+        fcs->SetRollTrimCmd(m_rollTrimPos);
+    } else {
+        (void)dt;
+    }
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::setControlStickRoll(double norm_val) {
+    if (fdmex) fdmex->GetFCS()->SetDaCmd(norm_val);
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::setControlStickPitch(double norm_val) {
+    if (fdmex) fdmex->GetFCS()->SetDeCmd(-norm_val); // JSBSim升降舵方向与通用习惯相反
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::setRudderPedal(double norm_val) {
+    if (fdmex) fdmex->GetFCS()->SetDrCmd(-norm_val); // JSBSim方向舵方向与通用习惯相反
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::setThrottle(int engine_idx, double norm_val) {
+    if (fdmex && engine_idx >= 0 && engine_idx < m_modelEngines) fdmex->GetFCS()->SetThrottleCmd(engine_idx, norm_val);
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::setThrottles(double norm_val) {
+    if (!fdmex) return;
+    auto fcs = fdmex->GetFCS();
+    for (int i = 0; i < m_modelEngines; ++i) fcs->SetThrottleCmd(i, norm_val);
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::setGearHandle(bool down) {
+    if (fdmex) fdmex->GetFCS()->SetGearCmd(down ? 1.0 : 0.0);
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::setBrakes(double left, double right) {
+    if (!fdmex) return;
+    auto fcs = fdmex->GetFCS();
+    fcs->SetLBrake(left);
+    fcs->SetRBrake(right);
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::setSpeedBrakes(double norm_val) {
+    if (!fdmex) return;
+    if (norm_val > 0) fdmex->GetFCS()->SetDsbCmd(1.0);
+    else if (norm_val < 0) fdmex->GetFCS()->SetDsbCmd(0.0);
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::setTrimSwitchRoll(double val) {
+    if constexpr (Trim::enabled) m_rollTrimSw = val;
+    else (void)val;
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::setTrimSwitchPitch(double val) {
+    if constexpr (Trim::enabled) m_pitchTrimSw = -val; // 和源文件逻辑保持一致
+    else (void)val;
+}
+
+template<class... Policies>
+void JSBSimAdapter<Policies...>::applyControls(const ControlFrame& controls) {
+    if (!fdmex) return;
+    auto fcs = fdmex->GetFCS();
+    const std::uint32_t v = controls.valid;
+
+    if (v & ControlFrame::Roll) fcs->SetDaCmd(controls.roll);
+    if (v & ControlFrame::Pitch) fcs->SetDeCmd(-controls.pitch); // JSBSim升降舵方向与通用习惯相反
+    if (v & ControlFrame::Rudder) fcs->SetDrCmd(-controls.rudder); // JSBSim方向舵方向与通用习惯相反
+    if (v & ControlFrame::ThrottleAll) {
+        for (int i = 0; i < m_modelEngines; ++i) fcs->SetThrottleCmd(i, controls.throttle_all);
+    }
+    if (v & ControlFrame::Throttle) {
+        const int engines = std::min(m_modelEngines, static_cast<int>(ControlFrame::MAX_ENGINES));
+        for (int i = 0; i < engines; ++i) {
+            if (controls.throttle_engines & (1u << i)) fcs->SetThrottleCmd(i, controls.throttle[i]);
+        }
+    }
+    if (v & ControlFrame::Gear) fcs->SetGearCmd(controls.gear_down ? 1.0 : 0.0);
+    if (v & ControlFrame::Brakes) {
+        fcs->SetLBrake(controls.brake_left);
+        fcs->SetRBrake(controls.brake_right);
+    }
+    if (v & ControlFrame::SpeedBrake) {
+        if (controls.speed_brake > 0) fcs->SetDsbCmd(1.0);
+        else if (controls.speed_brake < 0) fcs->SetDsbCmd(0.0);
+    }
+    if constexpr (Trim::enabled) {
+        if (v & ControlFrame::TrimRoll) m_rollTrimSw = controls.trim_roll;
+        if (v & ControlFrame::TrimPitch) m_pitchTrimSw = -controls.trim_pitch; // 与 setTrimSwitchPitch 一致
+    }
+}
+
+// 应用起点最接近的到期指令: 时间戳早于 当前时间 + 半个步长
+template<class... Policies>
+void JSBSimAdapter<Policies...>::applyQueuedCommands(double step_dt) {
+    if (!m_commands) return;
+    ControlFrame due;
+    if (m_commands->popDue(fdmex->GetSimTime() + 0.5 * step_dt, due)) applyControls(due);
+}
+
+#endif // JSBSIM_ADAPTER_IMPL_HPP
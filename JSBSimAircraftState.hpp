@@ -3,7 +3,8 @@
 #define JSBSIM_AIRCRAFT_STATE_HPP
 
 #include "OeBase.hpp" // 复用我们之前的基础工具
-#include <vector>
+#include <cstddef>
+#include <type_traits>
 
 struct PropulsionState {
     double thrust_lbf = 0.0;
@@ -12,6 +13,45 @@ struct PropulsionState {
     double pla_pct = 0.0; // Power Lever Angle %
 };
 
+// --- 定容发动机数组 ---
+// 内联存储, 接口取 std::vector 的常用子集; 状态结构体因此可平凡复制,
+// 拷贝、环形缓冲、跨进程发布都是一次 memcpy, 稳态循环中不再有堆分配。
+// 超出容量的 resize()/assign() 截断到 CAPACITY(与 ControlFrame::MAX_ENGINES 一致)。
+class PropulsionArray {
+public:
+    static const int CAPACITY = 8;
+
+    std::size_t size() const { return static_cast<std::size_t>(m_size); }
+    bool empty() const { return m_size == 0; }
+    static constexpr std::size_t capacity() { return CAPACITY; }
+
+    void resize(std::size_t n) {
+        const int count = n < static_cast<std::size_t>(CAPACITY) ? static_cast<int>(n) : CAPACITY;
+        for (int i = m_size; i < count; ++i) m_items[i] = PropulsionState();
+        m_size = count;
+    }
+
+    void assign(std::size_t n, const PropulsionState& value) {
+        m_size = 0;
+        resize(n);
+        for (PropulsionState& p : *this) p = value;
+    }
+
+    void clear() { m_size = 0; }
+
+    PropulsionState& operator[](std::size_t i) { return m_items[i]; }
+    const PropulsionState& operator[](std::size_t i) const { return m_items[i]; }
+
+    PropulsionState* begin() { return m_items; }
+    PropulsionState* end() { return m_items + m_size; }
+    const PropulsionState* begin() const { return m_items; }
+    const PropulsionState* end() const { return m_items + m_size; }
+
+private:
+    PropulsionState m_items[CAPACITY];
+    int m_size = 0;
+};
+
 struct JSBSimAircraftState {
     // --- 运动学核心数据 ---
     oe_base::Vec3d position_ned;      // 位置 (北-东-地), 米
@@ -37,8 +77,11 @@ struct JSBSimAircraftState {
     bool on_ground = false;
 
     // --- 发动机数据 ---
-    int num_engines = 0;
-    std::vector<PropulsionState> propulsion;
+    int num_engines = 0;               // 不超过 PropulsionArray::CAPACITY
+    PropulsionArray propulsion;
 };
 
+static_assert(std::is_trivially_copyable<JSBSimAircraftState>::value,
+              "JSBSimAircraftState must stay trivially copyable (no heap-owning members)");
+
 #endif // JSBSIM_AIRCRAFT_STATE_HPP
\ No newline at end of file
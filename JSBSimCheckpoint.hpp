@@ -0,0 +1,43 @@
+// JSBSimCheckpoint.hpp
+#ifndef JSBSIM_CHECKPOINT_HPP
+#define JSBSIM_CHECKPOINT_HPP
+
+#include <cstdint>
+#include <vector>
+
+// --- FDM 完整状态快照 ---
+// 由 saveCheckpoint() 填写、restoreCheckpoint() 恢复, 纯内存数据,
+// 复制一个检查点即可从同一时刻分叉出新的推演分支。
+struct JSBSimCheckpoint {
+    // --- 积分状态 (FGPropagate) ---
+    double sim_time = 0.0;
+    double dt = 0.0;
+    double location_ecef_ft[3] = {};
+    double uvw_fps[3] = {};
+    double pqr_rps[3] = {};
+    double pqri_rps[3] = {};
+    double quat_local[4] = {};
+    double quat_eci[4] = {};
+    double inertial_velocity_fps[3] = {};
+    double inertial_position_ft[3] = {};
+
+    // --- 包装类自身的配平状态 ---
+    double pitch_trim_pos = 0.0;
+    double pitch_trim_rate = 0.0;
+    double pitch_trim_sw = 0.0;
+    double roll_trim_pos = 0.0;
+    double roll_trim_rate = 0.0;
+    double roll_trim_sw = 0.0;
+
+    // --- 属性树快照: 初始条件、FCS/作动器位置、发动机、油箱、起落架、系统 ---
+    std::uint64_t layout_id = 0;        // 属性列表指纹, 恢复时校验是否为同一机型
+    std::vector<double> property_values;
+
+    // --- 各发动机的运行与起动机状态(无可读属性) ---
+    std::vector<std::uint8_t> engine_running;
+    std::vector<std::uint8_t> engine_starter;
+
+    bool valid() const { return layout_id != 0; }
+};
+
+#endif // JSBSIM_CHECKPOINT_HPP
@@ -0,0 +1,185 @@
+// JSBSimCheckpointNodes.hpp
+// 仅供包装类的实现文件包含: 需要完整的JSBSim头文件
+#ifndef JSBSIM_CHECKPOINT_NODES_HPP
+#define JSBSIM_CHECKPOINT_NODES_HPP
+
+#include <JSBSim/FGFDMExec.h>
+#include <JSBSim/models/FGPropagate.h>
+#include <JSBSim/models/FGFCS.h>
+#include <JSBSim/models/FGPropulsion.h>
+#include <JSBSim/models/propulsion/FGEngine.h>
+#include <JSBSim/input_output/FGPropertyManager.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "JSBSimCheckpoint.hpp"
+
+// --- 检查点的属性节点表 ---
+// 首次保存时遍历属性树, 按白名单收集保存状态的数值叶节点: 初始条件(ic)、FCS命令与作动器位置(fcs)、
+// 起落架(gear)、各发动机与油箱的状态(propulsion/engine[n], propulsion/tank[n])以及机型自定义的
+// systems/ap; 之后保存/恢复只是按表逐项读写 double。
+// 只收集可读且可写的节点: 只写节点(如 propulsion/set-running)读出恒为0, 恢复时写回等于重放一次命令。
+// propulsion 下的全局命令(set-running、starter_cmd、cutoff_cmd、refuel、fuel_dump、active_engine)不在白名单内;
+// 发动机的运行与起动机状态没有可读属性, 经 FGEngine 接口单独保存。
+// 保存只读取状态, 不改变之后的轨迹。
+// JSBSim 未公开多步积分器的历史导数队列, 也未公开 FCS 各组件(FGFilter、FGActuator 的速率限制/滞环/延迟等)的内部历史,
+// 检查点不包含这些状态: 恢复时先复位 FCS 各组件的历史(FGFCS::InitModel), 再写回属性值(作动器与滤波器的输出),
+// 最后以恢复的状态重新计算导数并重置积分历史。因此从同一检查点多次恢复后的轨迹彼此逐位一致,
+// 但与保存后直接继续推进的轨迹并不逐位相同: 恢复后的最初几帧积分器按单步启动, 滤波器从当前输出重新开始,
+// 差异随时间衰减(见 checkpoint_roundtrip.cpp 的容差)。
+struct JSBSimCheckpointNodes {
+    std::vector<SGPropertyNode*> nodes;
+    std::uint64_t layout_id = 0;
+
+    void collect(JSBSim::FGFDMExec& fdmex) {
+        nodes.clear();
+        layout_id = 1469598103934665603ull; // FNV-1a 偏移基
+        auto root = fdmex.GetPropertyManager()->GetNode();
+        // 子树名, 以及只收集其下哪些子节点(nullptr 为全部)
+        static const struct { const char* subtree; const char* child; } ALLOWLIST[] = {
+            {"ic", nullptr},          {"fcs", nullptr},         {"gear", nullptr},
+            {"propulsion", "engine"}, {"propulsion", "tank"},   {"systems", nullptr},
+            {"ap", nullptr},
+        };
+        for (const auto& entry : ALLOWLIST) {
+            SGPropertyNode* subtree = root->GetNode(entry.subtree);
+            if (!subtree) continue;
+            if (!entry.child) {
+                walk(subtree);
+                continue;
+            }
+            for (int i = 0, n = subtree->nChildren(); i < n; ++i) {
+                SGPropertyNode* child = subtree->getChild(i);
+                if (std::strcmp(child->getName(), entry.child) == 0) walk(child);
+            }
+        }
+    }
+
+    void capture(JSBSim::FGFDMExec& fdmex, JSBSimCheckpoint& cp) {
+        if (nodes.empty()) collect(fdmex);
+        auto prop = fdmex.GetPropagate();
+
+        cp.sim_time = fdmex.GetSimTime();
+        cp.dt = fdmex.GetDeltaT();
+        for (unsigned i = 0; i < 3; ++i) {
+            cp.location_ecef_ft[i] = prop->GetLocation()(i + 1);
+            cp.uvw_fps[i] = prop->GetUVW()(i + 1);
+            cp.pqr_rps[i] = prop->GetPQR()(i + 1);
+            cp.pqri_rps[i] = prop->GetPQRi()(i + 1);
+            cp.inertial_velocity_fps[i] = prop->GetInertialVelocity()(i + 1);
+            cp.inertial_position_ft[i] = prop->GetInertialPosition()(i + 1);
+        }
+        for (unsigned i = 0; i < 4; ++i) {
+            cp.quat_local[i] = prop->GetQuaternion()(i + 1);
+            cp.quat_eci[i] = prop->GetQuaternionECI()(i + 1);
+        }
+
+        cp.layout_id = layout_id;
+        captureValues(fdmex, cp.property_values, cp.engine_running, cp.engine_starter);
+    }
+
+    bool apply(JSBSim::FGFDMExec& fdmex, const JSBSimCheckpoint& cp) {
+        if (nodes.empty()) collect(fdmex);
+        const std::size_t engines = fdmex.GetPropulsion()->GetNumEngines();
+        if (cp.layout_id != layout_id || cp.property_values.size() != nodes.size() ||
+            cp.engine_running.size() != engines || cp.engine_starter.size() != engines) {
+            return false;
+        }
+
+        // 组件内部历史不在检查点中, 先统一复位, 使恢复结果不取决于恢复前的飞行
+        fdmex.GetFCS()->InitModel();
+        applyValues(fdmex, cp.property_values, cp.engine_running, cp.engine_starter);
+
+        auto prop = fdmex.GetPropagate();
+        JSBSim::FGPropagate::VehicleState vs;
+        vs.vLocation = prop->GetLocation(); // 保留椭球参数, 再覆盖ECEF坐标
+        vs.vLocation = JSBSim::FGColumnVector3(cp.location_ecef_ft[0], cp.location_ecef_ft[1], cp.location_ecef_ft[2]);
+        vs.vUVW = JSBSim::FGColumnVector3(cp.uvw_fps[0], cp.uvw_fps[1], cp.uvw_fps[2]);
+        vs.vPQR = JSBSim::FGColumnVector3(cp.pqr_rps[0], cp.pqr_rps[1], cp.pqr_rps[2]);
+        vs.vPQRi = JSBSim::FGColumnVector3(cp.pqri_rps[0], cp.pqri_rps[1], cp.pqri_rps[2]);
+        vs.vInertialVelocity = JSBSim::FGColumnVector3(cp.inertial_velocity_fps[0], cp.inertial_velocity_fps[1], cp.inertial_velocity_fps[2]);
+        vs.vInertialPosition = JSBSim::FGColumnVector3(cp.inertial_position_ft[0], cp.inertial_position_ft[1], cp.inertial_position_ft[2]);
+        for (unsigned i = 0; i < 4; ++i) {
+            vs.qAttitudeLocal(i + 1) = cp.quat_local[i];
+            vs.qAttitudeECI(i + 1) = cp.quat_eci[i];
+        }
+        prop->SetVState(vs);
+
+        fdmex.Setsim_time(cp.sim_time);
+        fdmex.Setdt(cp.dt);
+
+        resync(fdmex);
+        return true;
+    }
+
+    // 白名单属性值与各发动机的运行/起动机状态, 检查点与 JSBSimLoadedState 共用; 须先 collect()
+    void captureValues(JSBSim::FGFDMExec& fdmex, std::vector<double>& values, std::vector<std::uint8_t>& running,
+                       std::vector<std::uint8_t>& starter) const {
+        values.resize(nodes.size());
+        for (std::size_t i = 0; i < nodes.size(); ++i) values[i] = nodes[i]->getDoubleValue();
+
+        auto propulsion = fdmex.GetPropulsion();
+        const unsigned engines = static_cast<unsigned>(propulsion->GetNumEngines());
+        running.resize(engines);
+        starter.resize(engines);
+        for (unsigned i = 0; i < engines; ++i) {
+            running[i] = propulsion->GetEngine(i)->GetRunning() ? 1 : 0;
+            starter[i] = propulsion->GetEngine(i)->GetStarter() ? 1 : 0;
+        }
+    }
+
+    bool applyValues(JSBSim::FGFDMExec& fdmex, const std::vector<double>& values, const std::vector<std::uint8_t>& running,
+                     const std::vector<std::uint8_t>& starter) const {
+        auto propulsion = fdmex.GetPropulsion();
+        const unsigned engines = static_cast<unsigned>(propulsion->GetNumEngines());
+        if (values.size() != nodes.size() || running.size() != engines || starter.size() != engines) return false;
+
+        for (std::size_t i = 0; i < nodes.size(); ++i) nodes[i]->setDoubleValue(values[i]);
+        for (unsigned i = 0; i < engines; ++i) {
+            propulsion->GetEngine(i)->SetRunning(running[i] != 0);
+            propulsion->GetEngine(i)->SetStarter(starter[i] != 0);
+        }
+        return true;
+    }
+
+private:
+    // 恢复后与 RunIC 相同: 暂停积分跑一帧, 在当前状态上重新计算各模型输出与导数, 并以之重置积分历史
+    static void resync(JSBSim::FGFDMExec& fdmex) {
+        fdmex.SuspendIntegration();
+        fdmex.Run();
+        fdmex.ResumeIntegration();
+        fdmex.GetPropagate()->InitializeDerivatives();
+    }
+
+    void walk(SGPropertyNode* node) {
+        const int children = node->nChildren();
+        if (children == 0) {
+            if (!node->getAttribute(SGPropertyNode::READ) || !node->getAttribute(SGPropertyNode::WRITE)) return;
+            switch (node->getType()) {
+                case simgear::props::BOOL:
+                case simgear::props::INT:
+                case simgear::props::LONG:
+                case simgear::props::FLOAT:
+                case simgear::props::DOUBLE:
+                    nodes.push_back(node);
+                    hash(node);
+                    break;
+                default:
+                    break;
+            }
+            return;
+        }
+        for (int i = 0; i < children; ++i) walk(node->getChild(i));
+    }
+
+    void hash(const SGPropertyNode* node) {
+        const char* name = node->getName();
+        for (std::size_t i = 0, n = std::strlen(name); i < n; ++i) {
+            layout_id = (layout_id ^ static_cast<unsigned char>(name[i])) * 1099511628211ull;
+        }
+        layout_id = (layout_id ^ static_cast<std::uint64_t>(node->getIndex())) * 1099511628211ull;
+    }
+};
+
+#endif // JSBSIM_CHECKPOINT_NODES_HPP
@@ -0,0 +1,45 @@
+// JSBSimLoadedState.hpp
+// 仅供实现文件包含: 需要完整的JSBSim头文件
+#ifndef JSBSIM_LOADED_STATE_HPP
+#define JSBSIM_LOADED_STATE_HPP
+
+#include <JSBSim/FGFDMExec.h>
+#include <JSBSim/initialization/FGInitialCondition.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "JSBSimCheckpointNodes.hpp"
+
+// --- 执行器加载完成时的状态 ---
+// LoadModel() 之后立即 capture(), 复用执行器前 restore() 回到与刚加载时相同的状态。
+// ResetToInitialConditions() 只让各子模型重新初始化(积分器、滤波器历史、油箱、发动机), 上一次使用写入的
+// FCS命令(油门、起落架、刹车、襟翼)、systems/ap 属性、发动机运行状态、初始条件(航迹倾角、滚转角、攻角等)
+// 与步长都会留下来; 这里在复位之后按检查点白名单写回加载时的属性值和发动机状态,
+// 再以加载时初始条件的副本覆盖初始条件, 并恢复步长。
+// 初始条件副本持有所属执行器的指针, 每个执行器一份, 不能跨执行器共用。
+struct JSBSimLoadedState {
+    JSBSimCheckpointNodes nodes;
+    std::vector<double> property_values;
+    std::vector<std::uint8_t> engine_running;
+    std::vector<std::uint8_t> engine_starter;
+    std::unique_ptr<JSBSim::FGInitialCondition> ic;
+    double dt = 0.0;
+
+    void capture(JSBSim::FGFDMExec& fdmex) {
+        nodes.collect(fdmex);
+        nodes.captureValues(fdmex, property_values, engine_running, engine_starter);
+        ic = std::make_unique<JSBSim::FGInitialCondition>(*fdmex.GetIC());
+        dt = fdmex.GetDeltaT();
+    }
+
+    // 不执行 RunIC, 留给调用方设置初始条件后执行
+    void restore(JSBSim::FGFDMExec& fdmex) const {
+        fdmex.ResetToInitialConditions(JSBSim::FGFDMExec::DONT_EXECUTE_RUN_IC);
+        nodes.applyValues(fdmex, property_values, engine_running, engine_starter);
+        *fdmex.GetIC() = *ic;
+        fdmex.Setdt(dt);
+    }
+};
+
+#endif // JSBSIM_LOADED_STATE_HPP
@@ -0,0 +1,106 @@
+// JSBSimStateFields.hpp
+#ifndef JSBSIM_STATE_FIELDS_HPP
+#define JSBSIM_STATE_FIELDS_HPP
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "JSBSimAircraftState.hpp"
+
+// --- JSBSimAircraftState 字段的名称表 ---
+// 记录器、批处理输出等按名字选择列时使用; 名称与结构体成员一致,
+// 向量成员拆分为 _x/_y/_z 分量, 发动机字段写作 "engine<i>.<成员名>"。
+struct StateFieldRef {
+    using Getter = double (*)(const JSBSimAircraftState&, int);
+    Getter getter = nullptr;
+    int engine = -1;
+
+    bool valid() const { return getter != nullptr; }
+    double operator()(const JSBSimAircraftState& s) const { return getter(s, engine); }
+};
+
+namespace state_fields {
+
+struct Entry {
+    const char* name;
+    StateFieldRef::Getter getter;
+};
+
+inline const Entry* scalarTable(std::size_t& count) {
+    static const Entry table[] = {
+        {"position_ned_x", [](const JSBSimAircraftState& s, int) { return s.position_ned.x(); }},
+        {"position_ned_y", [](const JSBSimAircraftState& s, int) { return s.position_ned.y(); }},
+        {"position_ned_z", [](const JSBSimAircraftState& s, int) { return s.position_ned.z(); }},
+        {"velocity_ned_x", [](const JSBSimAircraftState& s, int) { return s.velocity_ned.x(); }},
+        {"velocity_ned_y", [](const JSBSimAircraftState& s, int) { return s.velocity_ned.y(); }},
+        {"velocity_ned_z", [](const JSBSimAircraftState& s, int) { return s.velocity_ned.z(); }},
+        {"accel_ned_x", [](const JSBSimAircraftState& s, int) { return s.accel_ned.x(); }},
+        {"accel_ned_y", [](const JSBSimAircraftState& s, int) { return s.accel_ned.y(); }},
+        {"accel_ned_z", [](const JSBSimAircraftState& s, int) { return s.accel_ned.z(); }},
+        {"altitude_sl_m", [](const JSBSimAircraftState& s, int) { return s.altitude_sl_m; }},
+        {"roll_rad", [](const JSBSimAircraftState& s, int) { return s.roll_rad; }},
+        {"pitch_rad", [](const JSBSimAircraftState& s, int) { return s.pitch_rad; }},
+        {"yaw_rad", [](const JSBSimAircraftState& s, int) { return s.yaw_rad; }},
+        {"ang_vel_rps_x", [](const JSBSimAircraftState& s, int) { return s.ang_vel_rps.x(); }},
+        {"ang_vel_rps_y", [](const JSBSimAircraftState& s, int) { return s.ang_vel_rps.y(); }},
+        {"ang_vel_rps_z", [](const JSBSimAircraftState& s, int) { return s.ang_vel_rps.z(); }},
+        {"g_load", [](const JSBSimAircraftState& s, int) { return s.g_load; }},
+        {"mach", [](const JSBSimAircraftState& s, int) { return s.mach; }},
+        {"alpha_rad", [](const JSBSimAircraftState& s, int) { return s.alpha_rad; }},
+        {"beta_rad", [](const JSBSimAircraftState& s, int) { return s.beta_rad; }},
+        {"flight_path_rad", [](const JSBSimAircraftState& s, int) { return s.flight_path_rad; }},
+        {"calibrated_airspeed_kts", [](const JSBSimAircraftState& s, int) { return s.calibrated_airspeed_kts; }},
+        {"total_weight_lbs", [](const JSBSimAircraftState& s, int) { return s.total_weight_lbs; }},
+        {"fuel_weight_lbs", [](const JSBSimAircraftState& s, int) { return s.fuel_weight_lbs; }},
+        {"on_ground", [](const JSBSimAircraftState& s, int) { return s.on_ground ? 1.0 : 0.0; }},
+        {"num_engines", [](const JSBSimAircraftState& s, int) { return static_cast<double>(s.num_engines); }},
+    };
+    count = sizeof(table) / sizeof(table[0]);
+    return table;
+}
+
+inline const Entry* engineTable(std::size_t& count) {
+    static const Entry table[] = {
+        {"thrust_lbf", [](const JSBSimAircraftState& s, int e) { return e < s.num_engines ? s.propulsion[e].thrust_lbf : 0.0; }},
+        {"rpm", [](const JSBSimAircraftState& s, int e) { return e < s.num_engines ? s.propulsion[e].rpm : 0.0; }},
+        {"fuel_flow_pph", [](const JSBSimAircraftState& s, int e) { return e < s.num_engines ? s.propulsion[e].fuel_flow_pph : 0.0; }},
+        {"pla_pct", [](const JSBSimAircraftState& s, int e) { return e < s.num_engines ? s.propulsion[e].pla_pct : 0.0; }},
+    };
+    count = sizeof(table) / sizeof(table[0]);
+    return table;
+}
+
+} // namespace state_fields
+
+// 按名字查找字段, 未知名称返回无效引用
+inline StateFieldRef findStateField(const std::string& name) {
+    StateFieldRef ref;
+    std::size_t count = 0;
+
+    if (name.compare(0, 6, "engine") == 0) {
+        const char* p = name.c_str() + 6;
+        char* end = nullptr;
+        const long idx = std::strtol(p, &end, 10);
+        if (end == p || *end != '.' || idx < 0) return ref;
+        const state_fields::Entry* table = state_fields::engineTable(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (std::strcmp(end + 1, table[i].name) == 0) {
+                ref.getter = table[i].getter;
+                ref.engine = static_cast<int>(idx);
+                return ref;
+            }
+        }
+        return ref;
+    }
+
+    const state_fields::Entry* table = state_fields::scalarTable(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (name == table[i].name) {
+            ref.getter = table[i].getter;
+            return ref;
+        }
+    }
+    return ref;
+}
+
+#endif // JSBSIM_STATE_FIELDS_HPP
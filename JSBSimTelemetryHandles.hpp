@@ -0,0 +1,74 @@
+// JSBSimTelemetryHandles.hpp
+// 仅供包装类的实现文件包含: 需要完整的JSBSim头文件
+#ifndef JSBSIM_TELEMETRY_HANDLES_HPP
+#define JSBSIM_TELEMETRY_HANDLES_HPP
+
+#include <JSBSim/FGFDMExec.h>
+#include <JSBSim/input_output/FGPropertyManager.h>
+#include <JSBSim/models/FGAccelerations.h>
+#include <JSBSim/models/FGPropagate.h>
+
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "TelemetrySchema.hpp"
+
+// --- init() 时解析好的遥测句柄表 ---
+// 缓存各子模型指针, 避免每帧重复 GetPropagate()/GetAuxiliary() 等查找;
+// 额外属性路径解析为 FGPropertyNode*, 每帧按平坦表顺序拷贝数值。
+struct JSBSimTelemetryHandles {
+    using ExecRef = JSBSim::FGFDMExec&;
+
+    decltype(std::declval<ExecRef>().GetPropagate()) prop{};
+    decltype(std::declval<ExecRef>().GetAuxiliary()) aux{};
+    decltype(std::declval<ExecRef>().GetAccelerations()) accel{};
+    decltype(std::declval<ExecRef>().GetFCS()) fcs{};
+    decltype(std::declval<ExecRef>().GetGroundReactions()) ground{};
+    decltype(std::declval<ExecRef>().GetPropulsion()) propulsion{};
+    decltype(std::declval<ExecRef>().GetMassBalance()) mass{};
+
+    unsigned groups = TelemetrySchema::All;
+    std::vector<JSBSim::FGPropertyNode*> nodes;
+
+    void resolve(JSBSim::FGFDMExec& fdmex, const TelemetrySchema& schema, std::vector<double>& values) {
+        prop = fdmex.GetPropagate();
+        aux = fdmex.GetAuxiliary();
+        accel = fdmex.GetAccelerations();
+        fcs = fdmex.GetFCS();
+        ground = fdmex.GetGroundReactions();
+        propulsion = fdmex.GetPropulsion();
+        mass = fdmex.GetMassBalance();
+        groups = schema.groups;
+
+        auto pm = fdmex.GetPropertyManager();
+        nodes.clear();
+        nodes.reserve(schema.properties.size());
+        for (const auto& path : schema.properties) {
+            JSBSim::FGPropertyNode* node = pm->GetNode(path);
+            if (!node) std::cerr << "Telemetry property not found: " << path << std::endl;
+            nodes.push_back(node);
+        }
+        values.assign(nodes.size(), std::numeric_limits<double>::quiet_NaN());
+    }
+
+    bool has(TelemetrySchema::Group g) const { return (groups & g) != 0; }
+
+    // 本地系加速度 Tb2l * UVWdot, 英尺/秒^2; 逐分量展开, 不构造临时向量
+    void localAccelFromUVWdot(double& north, double& east, double& down) const {
+        const JSBSim::FGMatrix33& Tb2l = prop->GetTb2l();
+        const JSBSim::FGColumnVector3& uvwdot = accel->GetUVWdot();
+        const double u = uvwdot(1), v = uvwdot(2), w = uvwdot(3);
+        north = Tb2l(1, 1) * u + Tb2l(1, 2) * v + Tb2l(1, 3) * w;
+        east = Tb2l(2, 1) * u + Tb2l(2, 2) * v + Tb2l(2, 3) * w;
+        down = Tb2l(3, 1) * u + Tb2l(3, 2) * v + Tb2l(3, 3) * w;
+    }
+
+    void readProperties(std::vector<double>& values) const {
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            if (nodes[i]) values[i] = nodes[i]->getDoubleValue();
+        }
+    }
+};
+
+#endif // JSBSIM_TELEMETRY_HANDLES_HPP
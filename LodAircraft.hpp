@@ -0,0 +1,193 @@
+// LodAircraft.hpp
+#ifndef LOD_AIRCRAFT_HPP
+#define LOD_AIRCRAFT_HPP
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "ControlFrame.hpp"
+#include "PointMassModel.hpp"
+
+class ModelTemplateCache;
+
+// --- 细节层次(LOD)切换的飞机 ---
+// 背景飞机平时用 PointMassModel 推进, 需要时(进入传感器范围、被选中等)升级为完整的JSBSim模型,
+// 完整模型的创建与 init()(读盘/XML解析或从模型缓存克隆)在后台线程上进行, 可在进入预加载距离时提前开始;
+// 加载完成后的第一次 update() 以质点模型当前的位置/航向/速度/航迹倾角/滚转角作为初始条件 RunIC 并配平
+// (设置了配平缓存时按缓存查找), 加载完成前继续以质点模型推进。加载线程以 setVerbose(false) 加载, 不修改进程全局的
+// JSBSim调试级别, 需要关闭加载信息时在主线程上调用一次 ModelTemplateCache::setJSBSimDebugLevel(0)。降级时以JSBSim状态作为质点模型的起点并释放执行器。
+// FullModel 为 StandaloneJSBSimModel、V2 StandaloneJSBSim 或 JSBSimAdapter<...>。
+// 与 V2 StandaloneJSBSim 搭配时调用 surrogate().setAltitudeDown(true) 使两级的 position_ned.z 约定一致。
+// 切换在 update() 开始时进行, 与 update() 在同一线程调用即可。
+template<class FullModel>
+class LodAircraft {
+public:
+    enum class Level { Surrogate, Full };
+
+    // setFocusDistance() 的迟滞门限
+    struct Thresholds {
+        double preload_within_m = 25000.0; // 进入后在后台加载完整模型, 加载好的模型保留到升级
+        double promote_within_m = 20000.0;
+        double demote_beyond_m = 30000.0;
+    };
+
+    explicit LodAircraft(Level initial = Level::Surrogate) : m_requested(initial) {}
+
+    // --- 初始化与配置 ---
+    // 质点模型参数从同一份飞机数据读取, 读取失败时使用 PointMassParams::generic()
+    bool init(const std::string& jsbsim_root_dir, const std::string& aircraft_model) {
+        m_root = jsbsim_root_dir;
+        m_model = aircraft_model;
+        PointMassParams params;
+        if (!PointMassParams::fromAircraftXml(jsbsim_root_dir, aircraft_model, params)) {
+            std::cerr << "LodAircraft: no aircraft data for " << aircraft_model << ", using generic point-mass parameters" << std::endl;
+            params = PointMassParams::generic();
+        }
+        return m_surrogate.init(params);
+    }
+
+    // 升级时模型从缓存克隆, 降级时执行器归还缓存
+    void setModelCache(ModelTemplateCache* cache) { m_cache = cache; }
+    // 升级时在 init() 之后、RunIC 之前于 update() 的线程上调用, 用于设置配平缓存、指令队列等
+    void setFullModelSetup(std::function<void(FullModel&)> setup) { m_setup = std::move(setup); }
+    void setThresholds(const Thresholds& thresholds) { m_thresholds = thresholds; }
+
+    void setInitialConditions(double lat_deg, double lon_deg, double alt_m, double hdg_deg, double speed_kts) {
+        m_surrogate.setInitialConditions(lat_deg, lon_deg, alt_m, hdg_deg, speed_kts);
+    }
+
+    // 初始级别为 Full 时在此等待完整模型加载完成
+    bool runInitialConditions() {
+        if (!m_surrogate.runInitialConditions()) return false;
+        m_full.reset();
+        if (m_requested != Level::Full) return true;
+        preload();
+        return promote(m_loading.get());
+    }
+
+    // --- 细节层次 ---
+    void requestLevel(Level level) { m_requested = level; }
+    // 按与关注点(本机、传感器)的距离请求级别, 带迟滞避免在门限附近反复切换
+    void setFocusDistance(double distance_m) {
+        if (distance_m < m_thresholds.preload_within_m) preload();
+        if (distance_m < m_thresholds.promote_within_m) m_requested = Level::Full;
+        else if (distance_m > m_thresholds.demote_beyond_m) m_requested = Level::Surrogate;
+    }
+
+    // 在后台开始加载完整模型(已加载或正在加载时不做任何事), 之后的升级不再在 update() 中读盘
+    void preload() {
+        if (m_full || m_loading.valid()) return;
+        m_loading = std::async(std::launch::async, [root = m_root, model = m_model, cache = m_cache] {
+            return load(root, model, cache);
+        });
+    }
+
+    Level level() const { return m_full ? Level::Full : Level::Surrogate; }
+    int promotions() const { return m_promotions; }
+    int demotions() const { return m_demotions; }
+
+    // --- 核心更新 ---
+    void update(double dt) {
+        if (m_requested == Level::Full && !m_full && !m_promoteFailed) {
+            preload();
+            if (m_loading.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                m_promoteFailed = !promote(m_loading.get());
+            }
+        } else if (m_requested == Level::Surrogate && m_full) {
+            demote();
+        }
+        if (m_requested == Level::Surrogate) m_promoteFailed = false;
+
+        if (m_full) m_full->update(dt);
+        else m_surrogate.update(dt);
+    }
+
+    // --- 控制指令接口 ---
+    // 指令同时记录下来, 切换级别后重新施加到新的模型上
+    void setControlStickRoll(double norm_val) { applyControls(ControlFrame().setRoll(norm_val)); }
+    void setControlStickPitch(double norm_val) { applyControls(ControlFrame().setPitch(norm_val)); }
+    void setRudderPedal(double norm_val) { applyControls(ControlFrame().setRudder(norm_val)); }
+    void setThrottle(int engine_idx, double norm_val) { applyControls(ControlFrame().setThrottle(engine_idx, norm_val)); }
+    void setThrottles(double norm_val) { applyControls(ControlFrame().setThrottles(norm_val)); }
+    void setGearHandle(bool down) { applyControls(ControlFrame().setGearHandle(down)); }
+
+    void applyControls(const ControlFrame& controls) {
+        m_controls.merge(controls);
+        if (m_full) m_full->applyControls(controls);
+        else m_surrogate.applyControls(controls);
+    }
+
+    // --- 获取状态 ---
+    const JSBSimAircraftState& getState() const { return m_full ? m_full->getState() : m_surrogate.getState(); }
+    PointMassModel& surrogate() { return m_surrogate; }
+    FullModel* fullModel() { return m_full.get(); }
+
+private:
+    // 在加载线程上运行; 失败时返回 nullptr
+    static std::unique_ptr<FullModel> load(const std::string& root, const std::string& model, ModelTemplateCache* cache) {
+        try {
+            std::unique_ptr<FullModel> full(new FullModel());
+            full->setVerbose(false); // 不在加载线程上修改进程全局的JSBSim调试级别
+            if (cache) full->setModelCache(cache);
+            if (full->init(root, model)) return full;
+        } catch (const std::exception& e) {
+            std::cerr << "LodAircraft: " << e.what() << std::endl;
+        } catch (...) {
+        }
+        std::cerr << "LodAircraft: Failed to load full model " << model << std::endl;
+        return nullptr;
+    }
+
+    bool promote(std::unique_ptr<FullModel> full) {
+        if (!full) {
+            std::cerr << "LodAircraft: Failed to promote " << m_model << " to full model" << std::endl;
+            return false;
+        }
+        if (m_setup) m_setup(*full);
+
+        // 以质点模型的完整飞行状态(含航迹倾角与滚转角)作为初始条件并配平, 避免升级瞬间的姿态与速度跳变;
+        // 滚转角不为零时包装类按协调转弯配平(tTurn), 保持质点模型的滚转角
+        const JSBSimAircraftState& s = m_surrogate.getState();
+        const oe_base::Vec3d& v = s.velocity_ned;
+        full->setInitialConditions(s.position_ned.x(), s.position_ned.y(), s.altitude_sl_m,
+                                   s.yaw_rad * oe_base::angle::R2DCC, v.length() * oe_base::MPS2KTS);
+        full->setInitialFlightPath(s.flight_path_rad * oe_base::angle::R2DCC, s.roll_rad * oe_base::angle::R2DCC);
+        full->setTrimOnInit(true);
+        if (!full->runInitialConditions()) {
+            std::cerr << "LodAircraft: RunIC failed while promoting " << m_model << std::endl;
+            return false;
+        }
+        full->applyControls(m_controls);
+        m_full = std::move(full);
+        ++m_promotions;
+        return true;
+    }
+
+    void demote() {
+        m_surrogate.seedFromState(m_full->getState());
+        m_surrogate.applyControls(m_controls);
+        m_full.reset();
+        ++m_demotions;
+    }
+
+    PointMassModel m_surrogate;
+    std::unique_ptr<FullModel> m_full;
+    std::future<std::unique_ptr<FullModel>> m_loading; // 后台加载中或已加载、尚未升级的完整模型
+    std::string m_root;
+    std::string m_model;
+    ModelTemplateCache* m_cache = nullptr;
+    std::function<void(FullModel&)> m_setup;
+
+    ControlFrame m_controls;
+    Thresholds m_thresholds;
+    Level m_requested;
+    bool m_promoteFailed = false;
+    int m_promotions = 0;
+    int m_demotions = 0;
+};
+
+#endif // LOD_AIRCRAFT_HPP
@@ -0,0 +1,129 @@
+// ModelTemplateCache.cpp
+#include "ModelTemplateCache.hpp"
+#include "JSBSimLoadedState.hpp"
+
+#include <JSBSim/FGFDMExec.h>
+#include <JSBSim/simgear/misc/sg_path.hxx>
+
+#include <chrono>
+#include <iostream>
+
+ModelTemplateCache::ModelTemplateCache() = default;
+ModelTemplateCache::~ModelTemplateCache() = default;
+
+void ModelTemplateCache::Deleter::operator()(JSBSim::FGFDMExec* exec) const {
+    delete exec;
+}
+
+void ModelTemplateCache::setJSBSimDebugLevel(int level) {
+    JSBSim::FGJSBBase::debug_lvl = static_cast<short>(level);
+}
+
+ModelTemplateCache::ExecPtr ModelTemplateCache::loadCold(const std::string& jsbsim_root_dir, const std::string& aircraft_model,
+                                                         const ModelLoadOptions& options) {
+    ExecPtr exec(new JSBSim::FGFDMExec());
+    if (options.split_paths) {
+        exec->SetRootDir(SGPath::fromString(jsbsim_root_dir));
+        exec->SetAircraftPath(SGPath::from_string(jsbsim_root_dir + "/aircraft"));
+        exec->SetEnginePath(SGPath::from_string(jsbsim_root_dir + "/engine"));
+        exec->SetSystemsPath(SGPath::from_string(jsbsim_root_dir + "/systems"));
+    } else {
+        exec->SetRootDir(SGPath(jsbsim_root_dir));
+    }
+    if (options.debug_level >= 0) exec->SetDebugLevel(options.debug_level);
+    if (!exec->LoadModel(aircraft_model)) {
+        std::cerr << "Failed to load JSBSim model!" << std::endl;
+        return nullptr;
+    }
+    return exec;
+}
+
+ModelTemplateCache::ExecPtr ModelTemplateCache::loadTracked(const std::string& jsbsim_root_dir, const std::string& aircraft_model,
+                                                            const ModelLoadOptions& options) {
+    ExecPtr exec = loadCold(jsbsim_root_dir, aircraft_model, options);
+    if (!exec) return nullptr;
+    auto loaded = std::make_unique<JSBSimLoadedState>();
+    loaded->capture(*exec);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_loaded[exec.get()] = std::move(loaded); // 地址可能属于已销毁的旧执行器, 直接覆盖
+    return exec;
+}
+
+ModelTemplateCache::ExecPtr ModelTemplateCache::acquire(const std::string& jsbsim_root_dir, const std::string& aircraft_model,
+                                                        const ModelLoadOptions& options) {
+    const auto start = std::chrono::steady_clock::now();
+    ExecPtr exec;
+    const JSBSimLoadedState* loaded = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_pool.find(makeKey(jsbsim_root_dir, aircraft_model, options));
+        if (it != m_pool.end() && !it->second.empty()) {
+            exec = std::move(it->second.back());
+            it->second.pop_back();
+            loaded = m_loaded.at(exec.get()).get();
+        }
+    }
+
+    if (exec) {
+        // 恢复到加载完成时的状态, RunIC 留给调用方
+        loaded->restore(*exec);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.hits;
+        m_stats.reuse_ms += ms;
+        return exec;
+    }
+
+    exec = loadTracked(jsbsim_root_dir, aircraft_model, options);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_stats.misses;
+    m_stats.cold_load_ms += ms;
+    return exec;
+}
+
+void ModelTemplateCache::release(const std::string& jsbsim_root_dir, const std::string& aircraft_model, ExecPtr exec,
+                                 const ModelLoadOptions& options) {
+    if (!exec) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_loaded.find(exec.get()) == m_loaded.end()) return; // 不知道其加载时的状态, 无法复位
+    m_pool[makeKey(jsbsim_root_dir, aircraft_model, options)].push_back(std::move(exec));
+}
+
+std::size_t ModelTemplateCache::prewarm(const std::string& jsbsim_root_dir, const std::string& aircraft_model, std::size_t count,
+                                        const ModelLoadOptions& options) {
+    std::size_t loaded = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        ExecPtr exec = loadTracked(jsbsim_root_dir, aircraft_model, options);
+        if (!exec) break;
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.cold_load_ms += ms;
+        }
+        release(jsbsim_root_dir, aircraft_model, std::move(exec), options);
+        ++loaded;
+    }
+    return loaded;
+}
+
+std::size_t ModelTemplateCache::pooled(const std::string& jsbsim_root_dir, const std::string& aircraft_model,
+                                       const ModelLoadOptions& options) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_pool.find(makeKey(jsbsim_root_dir, aircraft_model, options));
+    return it == m_pool.end() ? 0 : it->second.size();
+}
+
+ModelTemplateCache::Stats ModelTemplateCache::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void ModelTemplateCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& entry : m_pool) {
+        for (const ExecPtr& exec : entry.second) m_loaded.erase(exec.get()); // 已借出的执行器仍可归还
+    }
+    m_pool.clear();
+}
@@ -0,0 +1,91 @@
+// ModelTemplateCache.hpp
+#ifndef MODEL_TEMPLATE_CACHE_HPP
+#define MODEL_TEMPLATE_CACHE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// JSBSim类的正向声明
+namespace JSBSim {
+    class FGFDMExec;
+}
+struct JSBSimLoadedState;
+
+// --- 冷加载方式 ---
+// 须与拥有该执行器的包装类自身的加载方式一致; 不同路径方式加载的执行器分池存放
+struct ModelLoadOptions {
+    bool split_paths = false; // V2: 以 SGPath::fromString 处理UTF-8路径, 并分别设置 aircraft/engine/systems 目录
+    int debug_level = 0;      // 加载前设置的JSBSim调试级别, 0 不输出XML解析信息; <0 不修改(见 setJSBSimDebugLevel())
+};
+
+// --- 已加载飞机模型的缓存 ---
+// 以 "根目录 + 模型名" 为键, 缓存已经完成 LoadModel() 的 FGFDMExec。
+// JSBSim 不支持复制执行器, 也不能从内存中的XML文档加载模型, 因此这里缓存的是
+// 完整加载好的执行器实例: 模型实例销毁时归还缓存, 下次 acquire() 时恢复到刚加载完成时的状态
+// (见 JSBSimLoadedState: 子模型复位, FCS命令、发动机、systems 属性、初始条件与步长写回加载时的值),
+// 不读盘、不解析XML; 缓存为空时才冷加载。
+// 省下的是同一执行器在多次使用之间的重复加载: prewarm() 只是把冷加载提前到场景开始前,
+// 每个实例仍各自读盘解析一次, N 个同时存在的实例至少需要 N 次冷加载。线程安全。
+class ModelTemplateCache {
+public:
+    struct Deleter {
+        void operator()(JSBSim::FGFDMExec* exec) const;
+    };
+    using ExecPtr = std::unique_ptr<JSBSim::FGFDMExec, Deleter>;
+
+    struct Stats {
+        std::size_t hits = 0;        // 复用缓存实例的次数
+        std::size_t misses = 0;      // 冷加载的次数
+        double cold_load_ms = 0.0;   // 冷加载累计耗时
+        double reuse_ms = 0.0;       // 复位复用累计耗时
+    };
+
+    ModelTemplateCache();
+    ~ModelTemplateCache();
+    ModelTemplateCache(const ModelTemplateCache&) = delete;
+    ModelTemplateCache& operator=(const ModelTemplateCache&) = delete;
+
+    // 取得一个已加载好模型的执行器; 加载失败返回空指针
+    ExecPtr acquire(const std::string& jsbsim_root_dir, const std::string& aircraft_model,
+                    const ModelLoadOptions& options = ModelLoadOptions());
+    // 归还执行器, 供后续 acquire() 复用; 只接受由本缓存加载的执行器, 其他执行器直接销毁
+    void release(const std::string& jsbsim_root_dir, const std::string& aircraft_model, ExecPtr exec,
+                 const ModelLoadOptions& options = ModelLoadOptions());
+    // 冷加载 count 个实例放入缓存(每个实例一次完整的读盘与XML解析), 返回成功加载的数量
+    std::size_t prewarm(const std::string& jsbsim_root_dir, const std::string& aircraft_model, std::size_t count,
+                        const ModelLoadOptions& options = ModelLoadOptions());
+
+    std::size_t pooled(const std::string& jsbsim_root_dir, const std::string& aircraft_model,
+                       const ModelLoadOptions& options = ModelLoadOptions()) const;
+    Stats stats() const;
+    void clear();
+
+    // 不经缓存直接冷加载一个执行器
+    static ExecPtr loadCold(const std::string& jsbsim_root_dir, const std::string& aircraft_model,
+                            const ModelLoadOptions& options = ModelLoadOptions());
+
+    // JSBSim 的调试级别是进程全局变量, SetDebugLevel() 在任何线程上调用都会改写它。
+    // 多线程加载时在主线程上、加载线程启动前调用一次, 各加载方以 debug_level < 0 加载
+    static void setJSBSimDebugLevel(int level);
+
+private:
+    static std::string makeKey(const std::string& jsbsim_root_dir, const std::string& aircraft_model,
+                               const ModelLoadOptions& options) {
+        return jsbsim_root_dir + '\n' + aircraft_model + (options.split_paths ? "\n1" : "\n0");
+    }
+
+    // 冷加载并记录加载完成时的状态
+    ExecPtr loadTracked(const std::string& jsbsim_root_dir, const std::string& aircraft_model, const ModelLoadOptions& options);
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, std::vector<ExecPtr>> m_pool;
+    // 本缓存加载的每个执行器(池中的与已借出的)加载完成时的状态
+    std::unordered_map<const JSBSim::FGFDMExec*, std::unique_ptr<JSBSimLoadedState>> m_loaded;
+    Stats m_stats;
+};
+
+#endif // MODEL_TEMPLATE_CACHE_HPP
@@ -0,0 +1,279 @@
+// MonteCarloRunner.hpp
+#ifndef MONTE_CARLO_RUNNER_HPP
+#define MONTE_CARLO_RUNNER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "JSBSimAircraftState.hpp"
+#include "ModelTemplateCache.hpp"
+
+// --- 散布参数: 截断正态分布 ---
+struct Dispersion {
+    double nominal = 0.0;
+    double sigma = 0.0;
+    double min = -std::numeric_limits<double>::infinity();
+    double max = std::numeric_limits<double>::infinity();
+
+    Dispersion() = default;
+    Dispersion(double nominal_, double sigma_ = 0.0) : nominal(nominal_), sigma(sigma_) {}
+    Dispersion(double nominal_, double sigma_, double min_, double max_) : nominal(nominal_), sigma(sigma_), min(min_), max(max_) {}
+};
+
+// --- 控制指令时间表中的一段 ---
+// [t_start, t_end) 内施加给定的杆舵量, 幅值按 amplitude_scale 的抽样值缩放
+struct ControlSegment {
+    double t_start = 0.0;
+    double t_end = 0.0;
+    double roll = 0.0;     // -1.0 to 1.0
+    double pitch = 0.0;    // -1.0 to 1.0
+    double rudder = 0.0;   // -1.0 to 1.0
+    Dispersion amplitude_scale{1.0};
+};
+
+struct DispersionSpec {
+    // setInitialConditions 参数
+    Dispersion lat_deg, lon_deg, alt_m, hdg_deg, speed_kts;
+    Dispersion throttle{0.8};
+    std::vector<ControlSegment> schedule;
+
+    double duration_s = 60.0;
+    double dt = 1.0 / 60.0;
+};
+
+// --- 单次运行的摘要 ---
+struct MonteCarloRunSummary {
+    std::uint64_t run = 0;
+    bool ok = false;           // 初始条件成功且运行结束
+
+    // 本次抽样的输入
+    double lat_deg = 0.0, lon_deg = 0.0, alt_m = 0.0, hdg_deg = 0.0, speed_kts = 0.0, throttle = 0.0;
+
+    // 运行统计
+    double min_g_load = 0.0, max_g_load = 0.0;
+    double min_alpha_rad = 0.0, max_alpha_rad = 0.0;
+    double altitude_loss_m = 0.0;   // 初始高度 - 最低高度
+    double final_altitude_m = 0.0;
+    double max_mach = 0.0;
+    double min_calibrated_airspeed_kts = 0.0;
+    bool ground_contact = false;
+};
+
+// --- 全部运行的汇总 ---
+struct MonteCarloAggregate {
+    struct Stat {
+        double min = std::numeric_limits<double>::infinity();
+        double max = -std::numeric_limits<double>::infinity();
+        double sum = 0.0, sum2 = 0.0;
+        std::size_t n = 0;
+
+        void add(double v) { min = std::min(min, v); max = std::max(max, v); sum += v; sum2 += v * v; ++n; }
+        double mean() const { return n ? sum / n : 0.0; }
+        double stddev() const { return n > 1 ? std::sqrt(std::max(0.0, (sum2 - sum * sum / n) / (n - 1))) : 0.0; }
+    };
+
+    std::size_t runs = 0, failed = 0, ground_contacts = 0;
+    Stat min_g_load, max_g_load, max_alpha_rad, altitude_loss_m, max_mach, min_calibrated_airspeed_kts;
+};
+
+// --- 并行蒙特卡洛运行器 ---
+// 每个工作线程只加载一次模型, 之后各次运行复用同一个实例, 运行之间以 resetToLoaded() 完整复位
+// (执行器回到加载完成时的状态, 包装类的配平、指令队列与多速率子步一并清零)。哪些运行共用一个实例取决于
+// 线程调度, 复位不完整时结果会随线程数变化; 第 i 次运行的随机数只由 (seed, i) 决定, 结果按运行序号顺序写出,
+// 因此同一种子在任意线程数下得到逐字节相同的结果文件(见 montecarlo_determinism.cpp)。
+template<class Model>
+class MonteCarloRunner {
+public:
+    MonteCarloRunner(std::string jsbsim_root_dir, std::string aircraft_model, unsigned num_threads = 0)
+        : m_root(std::move(jsbsim_root_dir)), m_model(std::move(aircraft_model)),
+          m_threads(num_threads ? num_threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+    // spec.dt 与 spec.duration_s 须为正
+    bool run(const DispersionSpec& spec, std::size_t runs, std::uint64_t seed, const std::string& result_path) {
+        if (!(spec.dt > 0.0) || !(spec.duration_s > 0.0)) {
+            std::cerr << "MonteCarloRunner: dt and duration must be positive (dt = " << spec.dt
+                      << ", duration = " << spec.duration_s << ")" << std::endl;
+            return false;
+        }
+        m_out = std::fopen(result_path.c_str(), "w");
+        if (!m_out) {
+            std::cerr << "Failed to open result file: " << result_path << std::endl;
+            return false;
+        }
+        std::fprintf(m_out, "run,ok,lat_deg,lon_deg,alt_m,hdg_deg,speed_kts,throttle,"
+                            "min_g_load,max_g_load,min_alpha_rad,max_alpha_rad,altitude_loss_m,final_altitude_m,"
+                            "max_mach,min_calibrated_airspeed_kts,ground_contact\n");
+
+        m_results.assign(runs, MonteCarloRunSummary{});
+        m_done.assign(runs, 0);
+        m_nextRun.store(0);
+        m_nextWrite = 0;
+        m_aggregate = MonteCarloAggregate{};
+
+        // 调试级别为进程全局, 在工作线程启动前设置一次; 工作线程以 setVerbose(false) 加载, 不再修改它
+        ModelTemplateCache::setJSBSimDebugLevel(0);
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < m_threads; ++t) {
+            workers.emplace_back([this, &spec, runs, seed] { workerLoop(spec, runs, seed); });
+        }
+        for (auto& w : workers) w.join();
+
+        std::fclose(m_out);
+        m_out = nullptr;
+        return m_aggregate.failed < m_aggregate.runs || runs == 0;
+    }
+
+    const MonteCarloAggregate& aggregate() const { return m_aggregate; }
+
+private:
+    // --- 可复现的随机数: splitmix64 派生每次运行的独立流 ---
+    struct Rng {
+        std::uint64_t s;
+        explicit Rng(std::uint64_t seed) : s(seed) {}
+        std::uint64_t next() {
+            std::uint64_t z = (s += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+        double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+        double normal() {
+            // Box-Muller, 不依赖标准库分布的实现差异
+            const double u1 = std::max(uniform(), 1e-300);
+            const double u2 = uniform();
+            return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * oe_base::PI * u2);
+        }
+        double sample(const Dispersion& d) {
+            const double v = d.nominal + (d.sigma > 0.0 ? d.sigma * normal() : 0.0);
+            return std::min(d.max, std::max(d.min, v));
+        }
+    };
+
+    void workerLoop(const DispersionSpec& spec, std::size_t runs, std::uint64_t seed) {
+        std::vector<double> scales(spec.schedule.size());
+        // 本线程的模型实例, 在第一次运行时加载; 加载失败时之后的运行重新尝试
+        auto aircraft = std::make_unique<Model>();
+        aircraft->setVerbose(false);
+        bool loaded = false;
+
+        for (std::size_t i = m_nextRun.fetch_add(1); i < runs; i = m_nextRun.fetch_add(1)) {
+            Rng rng(seed ^ (0xD1B54A32D192ED03ull * (i + 1)));
+            MonteCarloRunSummary& r = m_results[i];
+            r.run = i;
+            r.lat_deg = rng.sample(spec.lat_deg);
+            r.lon_deg = rng.sample(spec.lon_deg);
+            r.alt_m = rng.sample(spec.alt_m);
+            r.hdg_deg = rng.sample(spec.hdg_deg);
+            r.speed_kts = rng.sample(spec.speed_kts);
+            r.throttle = rng.sample(spec.throttle);
+            for (std::size_t k = 0; k < scales.size(); ++k) scales[k] = rng.sample(spec.schedule[k].amplitude_scale);
+
+            // 每次运行都从加载完成时的状态开始, 与此前在本线程上跑过哪些运行无关
+            if (loaded) loaded = aircraft->resetToLoaded();
+            if (!loaded) loaded = aircraft->init(m_root, m_model);
+            if (loaded) {
+                aircraft->setInitialConditions(r.lat_deg, r.lon_deg, r.alt_m, r.hdg_deg, r.speed_kts);
+                if (aircraft->runInitialConditions()) {
+                    simulate(*aircraft, spec, scales, r);
+                    r.ok = true;
+                }
+            }
+            complete(i);
+        }
+    }
+
+    void simulate(Model& aircraft, const DispersionSpec& spec, const std::vector<double>& scales, MonteCarloRunSummary& r) {
+        const JSBSimAircraftState& s0 = aircraft.getState();
+        const double initial_alt = s0.altitude_sl_m;
+        double min_alt = initial_alt;
+        r.min_g_load = r.max_g_load = s0.g_load;
+        r.min_alpha_rad = r.max_alpha_rad = s0.alpha_rad;
+        r.max_mach = s0.mach;
+        r.min_calibrated_airspeed_kts = s0.calibrated_airspeed_kts;
+
+        const long long steps = static_cast<long long>(std::ceil(spec.duration_s / spec.dt));
+        for (long long n = 0; n < steps; ++n) {
+            const double t = n * spec.dt;
+            double roll = 0.0, pitch = 0.0, rudder = 0.0;
+            for (std::size_t k = 0; k < spec.schedule.size(); ++k) {
+                const ControlSegment& seg = spec.schedule[k];
+                if (t >= seg.t_start && t < seg.t_end) {
+                    roll += seg.roll * scales[k];
+                    pitch += seg.pitch * scales[k];
+                    rudder += seg.rudder * scales[k];
+                }
+            }
+            aircraft.setControlStickRoll(std::max(-1.0, std::min(1.0, roll)));
+            aircraft.setControlStickPitch(std::max(-1.0, std::min(1.0, pitch)));
+            aircraft.setRudderPedal(std::max(-1.0, std::min(1.0, rudder)));
+            aircraft.setThrottles(r.throttle);
+
+            aircraft.update(spec.dt);
+
+            const JSBSimAircraftState& s = aircraft.getState();
+            r.min_g_load = std::min(r.min_g_load, s.g_load);
+            r.max_g_load = std::max(r.max_g_load, s.g_load);
+            r.min_alpha_rad = std::min(r.min_alpha_rad, s.alpha_rad);
+            r.max_alpha_rad = std::max(r.max_alpha_rad, s.alpha_rad);
+            r.max_mach = std::max(r.max_mach, s.mach);
+            r.min_calibrated_airspeed_kts = std::min(r.min_calibrated_airspeed_kts, s.calibrated_airspeed_kts);
+            min_alt = std::min(min_alt, s.altitude_sl_m);
+            r.ground_contact = r.ground_contact || s.on_ground;
+        }
+        r.altitude_loss_m = initial_alt - min_alt;
+        r.final_altitude_m = aircraft.getState().altitude_sl_m;
+    }
+
+    // 运行完成后, 将已完成的连续前缀按序号写出并计入汇总
+    void complete(std::size_t i) {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        m_done[i] = 1;
+        while (m_nextWrite < m_done.size() && m_done[m_nextWrite]) {
+            const MonteCarloRunSummary& r = m_results[m_nextWrite];
+            std::fprintf(m_out, "%llu,%d,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%d\n",
+                         static_cast<unsigned long long>(r.run), r.ok ? 1 : 0,
+                         r.lat_deg, r.lon_deg, r.alt_m, r.hdg_deg, r.speed_kts, r.throttle,
+                         r.min_g_load, r.max_g_load, r.min_alpha_rad, r.max_alpha_rad, r.altitude_loss_m, r.final_altitude_m,
+                         r.max_mach, r.min_calibrated_airspeed_kts, r.ground_contact ? 1 : 0);
+
+            ++m_aggregate.runs;
+            if (!r.ok) {
+                ++m_aggregate.failed;
+            } else {
+                if (r.ground_contact) ++m_aggregate.ground_contacts;
+                m_aggregate.min_g_load.add(r.min_g_load);
+                m_aggregate.max_g_load.add(r.max_g_load);
+                m_aggregate.max_alpha_rad.add(r.max_alpha_rad);
+                m_aggregate.altitude_loss_m.add(r.altitude_loss_m);
+                m_aggregate.max_mach.add(r.max_mach);
+                m_aggregate.min_calibrated_airspeed_kts.add(r.min_calibrated_airspeed_kts);
+            }
+            ++m_nextWrite;
+        }
+        std::fflush(m_out);
+    }
+
+    std::string m_root;
+    std::string m_model;
+    unsigned m_threads;
+
+    std::vector<MonteCarloRunSummary> m_results;
+    std::vector<unsigned char> m_done;
+    std::atomic<std::size_t> m_nextRun{0};
+
+    std::mutex m_writeMutex;
+    std::size_t m_nextWrite = 0;
+    std::FILE* m_out = nullptr;
+    MonteCarloAggregate m_aggregate;
+};
+
+#endif // MONTE_CARLO_RUNNER_HPP
@@ -0,0 +1,150 @@
+// PerfStats.hpp
+#ifndef PERF_STATS_HPP
+#define PERF_STATS_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// --- update() 热路径计时 ---
+// 定义 JSBSIM_ENABLE_PERF_STATS 编译时启用(如 -DJSBSIM_ENABLE_PERF_STATS);
+// 未定义时只有计时宏展开为空, getPerfStats() 返回 enabled == false 的空统计。
+// 统计由模型所在的仿真线程写入, 查询/复位也应在该线程(或两帧之间)进行。
+
+enum class PerfPhase {
+    Update,          // 完整 update()
+    Trims,           // updateTrims()
+    Run,             // FGFDMExec::Run(), 多速率模式下按子步计
+    StateExtraction, // 从JSBSim提取状态(含SoA槽位)
+    Publish,         // 三缓冲发布
+    Count
+};
+
+struct PerfPhaseStats {
+    std::uint64_t calls = 0;
+    double total_us = 0.0;
+    double max_us = 0.0;
+    // 最近 PerfCounters::WINDOW 次调用的滚动百分位数
+    double p50_us = 0.0;
+    double p90_us = 0.0;
+    double p99_us = 0.0;
+
+    double meanUs() const { return calls ? total_us / calls : 0.0; }
+};
+
+struct PerfStats {
+    bool enabled = false;
+    std::uint64_t run_failures = 0;
+    std::array<PerfPhaseStats, static_cast<std::size_t>(PerfPhase::Count)> phases{};
+
+    const PerfPhaseStats& operator[](PerfPhase phase) const { return phases[static_cast<std::size_t>(phase)]; }
+
+    static const char* phaseName(PerfPhase phase) {
+        static const char* const NAMES[] = {"update", "trims", "run", "state_extraction", "publish"};
+        return NAMES[static_cast<std::size_t>(phase)];
+    }
+};
+
+// 计数器的类定义与宏无关, 包装类在启用与未启用计时的源文件之间布局一致;
+// 计时数据在第一次计时时才分配, 未启用计时时只占一个空指针。
+class PerfCounters {
+public:
+    static constexpr std::size_t WINDOW = 1024;
+
+    void record(PerfPhase phase, double us) {
+        Phase& p = data().phases[static_cast<std::size_t>(phase)];
+        ++p.calls;
+        p.total_us += us;
+        p.max_us = std::max(p.max_us, us);
+        p.window[p.next] = static_cast<float>(us);
+        p.next = (p.next + 1) % WINDOW;
+    }
+
+    void runFailed() { ++data().run_failures; }
+
+    // 从未计时(未以 JSBSIM_ENABLE_PERF_STATS 编译包装类)时返回 enabled == false 的空统计
+    PerfStats snapshot() const {
+        PerfStats s;
+        if (!m_data) return s;
+        s.enabled = true;
+        s.run_failures = m_data->run_failures;
+        std::array<float, WINDOW> sorted;
+        for (std::size_t i = 0; i < m_data->phases.size(); ++i) {
+            const Phase& p = m_data->phases[i];
+            PerfPhaseStats& out = s.phases[i];
+            out.calls = p.calls;
+            out.total_us = p.total_us;
+            out.max_us = p.max_us;
+
+            const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(p.calls, WINDOW));
+            if (n == 0) continue;
+            std::copy(p.window.begin(), p.window.begin() + n, sorted.begin());
+            std::sort(sorted.begin(), sorted.begin() + n);
+            out.p50_us = sorted[n * 50 / 100];
+            out.p90_us = sorted[n * 90 / 100];
+            out.p99_us = sorted[n * 99 / 100];
+        }
+        return s;
+    }
+
+    // 保留已分配的数据, 复位后的计时不再分配内存
+    void reset() {
+        if (m_data) *m_data = Data();
+    }
+
+private:
+    struct Phase {
+        std::uint64_t calls = 0;
+        double total_us = 0.0;
+        double max_us = 0.0;
+        std::size_t next = 0;
+        std::array<float, WINDOW> window{};
+    };
+
+    struct Data {
+        std::array<Phase, static_cast<std::size_t>(PerfPhase::Count)> phases{};
+        std::uint64_t run_failures = 0;
+    };
+
+    Data& data() {
+        if (!m_data) m_data = std::make_unique<Data>();
+        return *m_data;
+    }
+
+    std::unique_ptr<Data> m_data;
+};
+
+#ifdef JSBSIM_ENABLE_PERF_STATS
+
+class ScopedPerfTimer {
+public:
+    ScopedPerfTimer(PerfCounters& counters, PerfPhase phase)
+        : m_counters(counters), m_phase(phase), m_start(std::chrono::steady_clock::now()) {}
+    ~ScopedPerfTimer() {
+        m_counters.record(m_phase, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_start).count());
+    }
+    ScopedPerfTimer(const ScopedPerfTimer&) = delete;
+    ScopedPerfTimer& operator=(const ScopedPerfTimer&) = delete;
+
+private:
+    PerfCounters& m_counters;
+    PerfPhase m_phase;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#define JSBSIM_PERF_CONCAT_INNER(a, b) a##b
+#define JSBSIM_PERF_CONCAT(a, b) JSBSIM_PERF_CONCAT_INNER(a, b)
+#define JSBSIM_PERF_SCOPE(counters, phase) ScopedPerfTimer JSBSIM_PERF_CONCAT(perf_scope_, __LINE__)(counters, phase)
+#define JSBSIM_PERF_RUN_FAILED(counters) (counters).runFailed()
+
+#else
+
+#define JSBSIM_PERF_SCOPE(counters, phase) ((void)0)
+#define JSBSIM_PERF_RUN_FAILED(counters) ((void)0)
+
+#endif // JSBSIM_ENABLE_PERF_STATS
+
+#endif // PERF_STATS_HPP
@@ -0,0 +1,348 @@
+// PointMassModel.cpp
+// 不依赖JSBSim库, 单独编译即可: g++ -c PointMassModel.cpp -std=c++17
+#include "PointMassModel.hpp"
+#include "ControlFrame.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+const double LBS2N = 4.44822;
+const double EARTH_RADIUS_M = 6371008.8;
+const double MIN_SPEED_MPS = 5.0;
+
+// --- 标准大气(对流层 + 平流层底部) ---
+struct Atmosphere {
+    double density;     // kg/m^3
+    double sound_speed; // m/s
+};
+
+Atmosphere isaAtmosphere(double alt_m) {
+    const double h = std::max(alt_m, -500.0);
+    Atmosphere atm;
+    if (h < 11000.0) {
+        const double t = 288.15 - 0.0065 * h;
+        atm.density = 1.225 * std::pow(t / 288.15, 4.2559);
+        atm.sound_speed = std::sqrt(1.4 * 287.053 * t);
+    } else {
+        atm.density = 0.36392 * std::exp(-(h - 11000.0) / 6341.6);
+        atm.sound_speed = std::sqrt(1.4 * 287.053 * 216.65);
+    }
+    return atm;
+}
+
+// --- 简易XML读取 ---
+// 只取 <tag ...>数值</tag> 形式的标量, 足以读取 metrics/mass_balance/propulsion 中的几何与重量数据
+bool readFile(const std::string& path, std::string& content) {
+    std::ifstream file(path);
+    if (!file) return false;
+    std::ostringstream ss;
+    ss << file.rdbuf();
+    content = ss.str();
+    return true;
+}
+
+// 从 from 开始查找下一个 <tag>, 返回其数值与 unit 属性; pos 更新到该元素之后
+bool nextTagValue(const std::string& xml, const std::string& tag, std::size_t& pos, double& value, std::string& unit) {
+    const std::string open = "<" + tag;
+    std::size_t start = xml.find(open, pos);
+    while (start != std::string::npos) {
+        const char next = start + open.size() < xml.size() ? xml[start + open.size()] : '\0';
+        if (next == '>' || next == ' ' || next == '\t' || next == '\n' || next == '\r') break;
+        start = xml.find(open, start + open.size()); // <tagXXX 不是同一元素
+    }
+    if (start == std::string::npos) return false;
+    const std::size_t close = xml.find('>', start);
+    if (close == std::string::npos) return false;
+
+    unit.clear();
+    const std::string attrs = xml.substr(start + open.size(), close - start - open.size());
+    const std::size_t u = attrs.find("unit=\"");
+    if (u != std::string::npos) {
+        const std::size_t e = attrs.find('"', u + 6);
+        if (e != std::string::npos) unit = attrs.substr(u + 6, e - u - 6);
+    }
+
+    pos = close + 1;
+    std::istringstream ss(xml.substr(pos, xml.find('<', pos) - pos));
+    return static_cast<bool>(ss >> value);
+}
+
+bool tagValue(const std::string& xml, const std::string& tag, double& value, std::string& unit) {
+    std::size_t pos = 0;
+    return nextTagValue(xml, tag, pos, value, unit);
+}
+
+// 第一个 <tag ... attr="..."> 的属性值
+std::string tagAttribute(const std::string& xml, const std::string& tag, const std::string& attr, std::size_t pos = 0) {
+    const std::size_t start = xml.find("<" + tag + " ", pos);
+    if (start == std::string::npos) return std::string();
+    const std::size_t close = xml.find('>', start);
+    const std::size_t a = xml.find(attr + "=\"", start);
+    if (a == std::string::npos || a > close) return std::string();
+    const std::size_t b = a + attr.size() + 2;
+    return xml.substr(b, xml.find('"', b) - b);
+}
+
+double toFeet(double v, const std::string& unit) { return unit == "M" ? v * 3.28084 : v; }
+double toSquareFeet(double v, const std::string& unit) { return unit == "M2" ? v * 10.7639 : v; }
+double toPounds(double v, const std::string& unit) { return unit == "KG" ? v * 2.20462 : v; }
+
+} // namespace
+
+// --- 参数读取 ---
+bool PointMassParams::fromAircraftXml(const std::string& jsbsim_root_dir, const std::string& aircraft_model, PointMassParams& params) {
+    std::string xml;
+    if (!readFile(jsbsim_root_dir + "/aircraft/" + aircraft_model + "/" + aircraft_model + ".xml", xml)) {
+        return false;
+    }
+
+    double v = 0.0;
+    std::string unit;
+    if (tagValue(xml, "wingarea", v, unit)) params.wing_area_m2 = toSquareFeet(v, unit) / 10.7639;
+    if (tagValue(xml, "wingspan", v, unit)) params.wingspan_m = toFeet(v, unit) * oe_base::FT2M;
+
+    // 空重 + 所有点质量(乘员、货物等)
+    if (tagValue(xml, "emptywt", v, unit)) params.empty_weight_lbs = toPounds(v, unit);
+    std::size_t pos = xml.find("<pointmass");
+    while (pos != std::string::npos && nextTagValue(xml, "weight", pos, v, unit)) {
+        params.empty_weight_lbs += toPounds(v, unit);
+        pos = xml.find("<pointmass", pos);
+    }
+
+    // 所有油箱的当前油量
+    double fuel = 0.0;
+    pos = xml.find("<tank");
+    while (pos != std::string::npos && nextTagValue(xml, "contents", pos, v, unit)) {
+        fuel += toPounds(v, unit);
+        pos = xml.find("<tank", pos);
+    }
+    params.fuel_weight_lbs = fuel;
+
+    // 发动机台数与第一台的动力数据
+    int engines = 0;
+    for (pos = xml.find("<engine "); pos != std::string::npos; pos = xml.find("<engine ", pos + 1)) ++engines;
+    if (engines > 0) params.num_engines = engines;
+
+    const std::string engine_file = tagAttribute(xml, "engine", "file");
+    std::string engine_xml;
+    if (!engine_file.empty() && readFile(jsbsim_root_dir + "/engine/" + engine_file + ".xml", engine_xml)) {
+        if (tagValue(engine_xml, "milthrust", v, unit)) {
+            params.engine_type = EngineType::Turbine;
+            params.max_thrust_lbf = v;
+            if (tagValue(engine_xml, "maxthrust", v, unit)) params.max_thrust_lbf = std::max(params.max_thrust_lbf, v);
+            params.fuel_flow_full_pph = 0.8 * params.max_thrust_lbf; // 典型涡扇耗油率 0.8 lb/(lbf*h)
+        } else if (tagValue(engine_xml, "maxhp", v, unit)) {
+            params.engine_type = EngineType::Piston;
+            params.max_power_hp = v;
+            params.max_thrust_lbf = 3.0 * v;      // 定距螺旋桨静推力经验值
+            params.fuel_flow_full_pph = 0.45 * v; // 典型活塞耗油率 0.45 lb/(hp*h)
+        }
+    }
+
+    // 升力线斜率按 Helmbold 公式由展弦比估算
+    const double ar = params.wingspan_m * params.wingspan_m / std::max(params.wing_area_m2, 0.1);
+    params.cl_alpha = 2.0 * oe_base::PI * ar / (2.0 + std::sqrt(ar * ar + 4.0));
+    return true;
+}
+
+// --- 初始化与配置 ---
+bool PointMassModel::init(const std::string& jsbsim_root_dir, const std::string& aircraft_model) {
+    PointMassParams params;
+    if (!PointMassParams::fromAircraftXml(jsbsim_root_dir, aircraft_model, params)) {
+        std::cerr << "PointMassModel: Failed to read aircraft data for " << aircraft_model << std::endl;
+        return false;
+    }
+    return init(params);
+}
+
+bool PointMassModel::init(const PointMassParams& params) {
+    m_params = params;
+    m_params.num_engines = std::max(0, std::min(m_params.num_engines, static_cast<int>(ControlFrame::MAX_ENGINES)));
+    m_fuel_lbs = m_params.fuel_weight_lbs;
+    m_state.num_engines = m_params.num_engines;
+    m_state.propulsion.assign(m_state.num_engines, PropulsionState());
+    return true;
+}
+
+void PointMassModel::setInitialConditions(double lat_deg, double lon_deg, double alt_m, double hdg_deg, double speed_kts) {
+    m_icLat_deg = lat_deg;
+    m_icLon_deg = lon_deg;
+    m_icAlt_m = alt_m;
+    m_icHdg_deg = hdg_deg;
+    m_icSpeed_kts = speed_kts;
+}
+
+bool PointMassModel::runInitialConditions() {
+    m_lat_rad = m_icLat_deg * oe_base::angle::D2RCC;
+    m_lon_rad = m_icLon_deg * oe_base::angle::D2RCC;
+    m_alt_m = m_icAlt_m;
+    m_chi_rad = oe_base::aepcdRad(m_icHdg_deg * oe_base::angle::D2RCC);
+    m_speed_mps = m_icSpeed_kts * oe_base::KTS2MPS;
+    m_gamma_rad = 0.0;
+    m_phi_rad = 0.0;
+    m_fuel_lbs = m_params.fuel_weight_lbs;
+    m_gammaDot = m_chiDot = m_phiDot = 0.0;
+    m_load = 1.0;
+    updateState();
+    m_state.accel_ned.set(0.0, 0.0, 0.0);
+    return true;
+}
+
+void PointMassModel::seedFromState(const JSBSimAircraftState& state) {
+    m_lat_rad = state.position_ned.x() * oe_base::angle::D2RCC;
+    m_lon_rad = state.position_ned.y() * oe_base::angle::D2RCC;
+    m_alt_m = state.altitude_sl_m;
+
+    const oe_base::Vec3d& v = state.velocity_ned;
+    const double ground_speed = std::sqrt(v.x() * v.x() + v.y() * v.y());
+    m_speed_mps = v.length();
+    m_gamma_rad = std::atan2(-v.z(), ground_speed);
+    m_chi_rad = ground_speed > 0.1 ? std::atan2(v.y(), v.x()) : state.yaw_rad;
+    m_phi_rad = std::max(-m_params.max_bank_rad, std::min(state.roll_rad, m_params.max_bank_rad));
+    m_fuel_lbs = state.fuel_weight_lbs;
+    m_load = state.g_load;
+    m_gammaDot = m_chiDot = m_phiDot = 0.0;
+
+    if (!state.propulsion.empty()) m_throttle = state.propulsion[0].pla_pct / 100.0;
+    updateState();
+    m_state.accel_ned = state.accel_ned;
+}
+
+// --- 核心更新 ---
+void PointMassModel::update(double dt) {
+    if (dt <= 0.0) return;
+    const double g = oe_base::ETHGM;
+    const Atmosphere atm = isaAtmosphere(m_alt_m);
+    const double weight_lbs = m_params.empty_weight_lbs + m_fuel_lbs;
+    const double mass_kg = weight_lbs * oe_base::LBS2KG;
+    const double v = std::max(m_speed_mps, MIN_SPEED_MPS);
+    const double qs = 0.5 * atm.density * v * v * m_params.wing_area_m2;
+
+    // --- 法向过载: 杆量映射到 [min, max], 受最大升力系数限制 ---
+    double n_cmd = 1.0 + (m_pitch >= 0.0 ? m_pitch * (m_params.max_load_factor - 1.0)
+                                         : -m_pitch * (m_params.min_load_factor - 1.0));
+    const double n_aero = qs * m_params.cl_max / (mass_kg * g);
+    m_load = std::max(-n_aero, std::min(n_cmd, n_aero));
+
+    const double cl = m_load * mass_kg * g / qs;
+    m_alpha_rad = cl / m_params.cl_alpha;
+    const double ar = m_params.wingspan_m * m_params.wingspan_m / std::max(m_params.wing_area_m2, 0.1);
+    const double k = 1.0 / (oe_base::PI * m_params.oswald * ar);
+    const double cd = m_params.cd0 + (m_gearDown ? m_params.gear_cd0 : 0.0) + k * cl * cl;
+    const double drag_n = qs * cd;
+
+    // --- 推力: 活塞按功率/速度并受静推力限制, 涡轮按密度比衰减 ---
+    const double sigma = atm.density / 1.225;
+    double thrust_lbf = 0.0;
+    if (m_params.engine_type == PointMassParams::EngineType::Piston) {
+        const double power_w = m_params.max_power_hp * 745.7 * m_throttle * sigma;
+        thrust_lbf = std::min(m_params.max_thrust_lbf * m_throttle, 0.8 * power_w / v / LBS2N);
+    } else {
+        thrust_lbf = m_params.max_thrust_lbf * m_throttle * std::pow(sigma, 0.7);
+    }
+    m_thrust_lbf = m_fuel_lbs > 0.0 ? thrust_lbf : 0.0;
+    const double thrust_n = m_thrust_lbf * LBS2N * m_params.num_engines;
+
+    // --- 速度坐标系运动方程 ---
+    const double cos_gamma = std::cos(m_gamma_rad);
+    const double speed_dot = (thrust_n - drag_n) / mass_kg - g * std::sin(m_gamma_rad);
+    m_gammaDot = g / v * (m_load * std::cos(m_phi_rad) - cos_gamma);
+    m_chiDot = g * m_load * std::sin(m_phi_rad) / (v * std::max(cos_gamma, 0.05));
+    m_phiDot = m_roll * m_params.max_roll_rate_rps;
+
+    const double vn_prev = m_speed_mps * cos_gamma * std::cos(m_chi_rad);
+    const double ve_prev = m_speed_mps * cos_gamma * std::sin(m_chi_rad);
+    const double vd_prev = -m_speed_mps * std::sin(m_gamma_rad);
+
+    m_speed_mps = std::max(0.0, m_speed_mps + speed_dot * dt);
+    m_gamma_rad = std::max(-oe_base::PI / 2 + 0.01, std::min(m_gamma_rad + m_gammaDot * dt, oe_base::PI / 2 - 0.01));
+    m_chi_rad = oe_base::aepcdRad(m_chi_rad + m_chiDot * dt);
+    m_phi_rad = std::max(-m_params.max_bank_rad, std::min(m_phi_rad + m_phiDot * dt, m_params.max_bank_rad));
+
+    // 地面: 不穿地, 不下沉
+    if (m_alt_m <= 0.0 && m_gamma_rad < 0.0) m_gamma_rad = 0.0;
+
+    const double vn = m_speed_mps * std::cos(m_gamma_rad) * std::cos(m_chi_rad);
+    const double ve = m_speed_mps * std::cos(m_gamma_rad) * std::sin(m_chi_rad);
+    const double vd = -m_speed_mps * std::sin(m_gamma_rad);
+    const double r = EARTH_RADIUS_M + m_alt_m;
+    m_lat_rad += vn * dt / r;
+    m_lon_rad += ve * dt / (r * std::max(std::cos(m_lat_rad), 1e-6));
+    m_alt_m = std::max(0.0, m_alt_m - vd * dt);
+
+    m_fuel_lbs = std::max(0.0, m_fuel_lbs - m_params.fuel_flow_full_pph * m_throttle * m_params.num_engines * dt / 3600.0);
+
+    updateState();
+    m_state.accel_ned.set((vn - vn_prev) / dt, (ve - ve_prev) / dt, (vd - vd_prev) / dt);
+}
+
+void PointMassModel::updateState() {
+    JSBSimAircraftState& s = m_state;
+    const double lat_deg = m_lat_rad * oe_base::angle::R2DCC;
+    const double lon_deg = oe_base::aepcdDeg(m_lon_rad * oe_base::angle::R2DCC);
+    s.position_ned.set(lat_deg, lon_deg, m_altitudeDown ? -m_alt_m : m_alt_m);
+    s.altitude_sl_m = m_alt_m;
+
+    const double cos_gamma = std::cos(m_gamma_rad);
+    s.velocity_ned.set(m_speed_mps * cos_gamma * std::cos(m_chi_rad),
+                       m_speed_mps * cos_gamma * std::sin(m_chi_rad),
+                       -m_speed_mps * std::sin(m_gamma_rad));
+
+    // 姿态近似: 无侧滑, 俯仰角 = 航迹倾角 + 攻角
+    const double theta = m_gamma_rad + m_alpha_rad;
+    s.roll_rad = m_phi_rad;
+    s.pitch_rad = theta;
+    s.yaw_rad = m_chi_rad;
+    const double sp = std::sin(m_phi_rad), cp = std::cos(m_phi_rad);
+    const double st = std::sin(theta), ct = std::cos(theta);
+    s.ang_vel_rps.set(m_phiDot - m_chiDot * st,
+                      m_gammaDot * cp + m_chiDot * ct * sp,
+                      -m_gammaDot * sp + m_chiDot * ct * cp);
+
+    const Atmosphere atm = isaAtmosphere(m_alt_m);
+    s.g_load = m_load;
+    s.mach = m_speed_mps / atm.sound_speed;
+    s.alpha_rad = m_alpha_rad;
+    s.beta_rad = 0.0;
+    s.flight_path_rad = m_gamma_rad;
+    s.calibrated_airspeed_kts = m_speed_mps * std::sqrt(atm.density / 1.225) / oe_base::KTS2MPS; // 以当量空速近似
+
+    s.total_weight_lbs = m_params.empty_weight_lbs + m_fuel_lbs;
+    s.fuel_weight_lbs = m_fuel_lbs;
+    s.on_ground = m_alt_m <= 0.0;
+
+    for (int i = 0; i < s.num_engines; ++i) {
+        s.propulsion[i].thrust_lbf = m_thrust_lbf;
+        s.propulsion[i].rpm = 0.0;
+        s.propulsion[i].fuel_flow_pph = m_fuel_lbs > 0.0 ? m_params.fuel_flow_full_pph * m_throttle : 0.0;
+        s.propulsion[i].pla_pct = m_throttle * 100.0;
+    }
+}
+
+// --- 控制指令 ---
+void PointMassModel::setControlStickRoll(double norm_val) { m_roll = std::max(-1.0, std::min(norm_val, 1.0)); }
+void PointMassModel::setControlStickPitch(double norm_val) { m_pitch = std::max(-1.0, std::min(norm_val, 1.0)); }
+void PointMassModel::setRudderPedal(double) {}
+
+// 质点模型不区分单台发动机, 单台油门指令按所有发动机处理
+void PointMassModel::setThrottle(int engine_idx, double norm_val) {
+    if (engine_idx >= 0 && engine_idx < m_params.num_engines) setThrottles(norm_val);
+}
+
+void PointMassModel::setThrottles(double norm_val) { m_throttle = std::max(0.0, std::min(norm_val, 1.0)); }
+void PointMassModel::setGearHandle(bool down) { m_gearDown = down; }
+
+void PointMassModel::applyControls(const ControlFrame& controls) {
+    const std::uint32_t v = controls.valid;
+    if (v & ControlFrame::Roll) setControlStickRoll(controls.roll);
+    if (v & ControlFrame::Pitch) setControlStickPitch(controls.pitch);
+    if (v & ControlFrame::ThrottleAll) setThrottles(controls.throttle_all);
+    if (v & ControlFrame::Throttle) {
+        for (int i = 0; i < m_params.num_engines; ++i) {
+            if (controls.throttle_engines & (1u << i)) setThrottle(i, controls.throttle[i]);
+        }
+    }
+    if (v & ControlFrame::Gear) setGearHandle(controls.gear_down);
+}
@@ -0,0 +1,114 @@
+// PointMassModel.hpp
+#ifndef POINT_MASS_MODEL_HPP
+#define POINT_MASS_MODEL_HPP
+
+#include <string>
+#include "JSBSimAircraftState.hpp"
+
+struct ControlFrame;
+
+// --- 质点模型参数 ---
+// 可由 fromAircraftXml() 从JSBSim飞机/发动机XML中读取几何、重量与动力数据,
+// 读不到的气动系数按展弦比估算; generic() 提供无需数据文件的轻型单发默认值。
+struct PointMassParams {
+    enum class EngineType { Piston, Turbine };
+
+    double wing_area_m2 = 16.2;
+    double wingspan_m = 10.9;
+    double empty_weight_lbs = 1800.0;   // 空重 + 固定载荷(pointmass)
+    double fuel_weight_lbs = 300.0;
+
+    int num_engines = 1;
+    EngineType engine_type = EngineType::Piston;
+    double max_power_hp = 160.0;        // 单台, 活塞发动机
+    double max_thrust_lbf = 480.0;      // 单台静推力
+    double fuel_flow_full_pph = 60.0;   // 单台满油门耗油率
+
+    double cl_alpha = 4.6;              // 1/rad
+    double cl_max = 1.5;
+    double cd0 = 0.027;
+    double oswald = 0.8;
+    double gear_cd0 = 0.008;            // 起落架放下的附加零升阻力
+
+    double max_load_factor = 3.8;
+    double min_load_factor = -1.5;
+    double max_roll_rate_rps = 1.2;
+    double max_bank_rad = 1.4;
+
+    static PointMassParams generic() { return PointMassParams(); }
+    // 读取 <root>/aircraft/<model>/<model>.xml 及其引用的第一个发动机文件; 找不到飞机文件时返回 false
+    static bool fromAircraftXml(const std::string& jsbsim_root_dir, const std::string& aircraft_model, PointMassParams& params);
+};
+
+// --- 三自由度质点模型 ---
+// 速度坐标系下积分速度大小、航迹倾角、航迹方位角, 滚转角按杆量以限定角速率变化,
+// 俯仰杆量映射为法向过载指令(受最大升力系数限制)。接口与 StandaloneJSBSimModel 一致,
+// 可作为大规模场景中背景飞机的轻量替身, 也可在没有JSBSim数据的机器上做规模测试。
+class PointMassModel {
+public:
+    PointMassModel() = default;
+
+    // --- 初始化与配置 ---
+    bool init(const std::string& jsbsim_root_dir, const std::string& aircraft_model);
+    bool init(const PointMassParams& params);
+    void setInitialConditions(double lat_deg, double lon_deg, double alt_m, double hdg_deg, double speed_kts);
+    bool runInitialConditions();
+    // 以另一模型的状态为起点(细节层次切换), 航迹角、滚转角与油门一并继承
+    void seedFromState(const JSBSimAircraftState& state);
+
+    // position_ned.z 的符号: false 与 StandaloneJSBSimModel 相同(+高度), true 与 V2 相同(-高度)
+    void setAltitudeDown(bool down) { m_altitudeDown = down; }
+
+    // --- 核心更新 ---
+    void update(double dt);
+
+    // --- 控制指令接口 ---
+    void setControlStickRoll(double norm_val);    // -1.0 to 1.0, 滚转角速率指令
+    void setControlStickPitch(double norm_val);   // -1.0 to 1.0, 过载指令
+    void setRudderPedal(double norm_val);         // 质点模型不响应
+    void setThrottle(int engine_idx, double norm_val);
+    void setThrottles(double norm_val);
+    void setGearHandle(bool down);
+    void applyControls(const ControlFrame& controls);
+
+    // --- 获取状态 ---
+    const JSBSimAircraftState& getState() const { return m_state; }
+    const PointMassParams& getParams() const { return m_params; }
+    double getThrottle() const { return m_throttle; }
+
+private:
+    void updateState();
+
+    PointMassParams m_params;
+    JSBSimAircraftState m_state;
+    bool m_altitudeDown = false;
+
+    // --- 积分状态 ---
+    double m_lat_rad = 0.0;
+    double m_lon_rad = 0.0;
+    double m_alt_m = 0.0;
+    double m_speed_mps = 0.0;     // 真空速
+    double m_gamma_rad = 0.0;     // 航迹倾角
+    double m_chi_rad = 0.0;       // 航迹方位角
+    double m_phi_rad = 0.0;       // 滚转角
+    double m_fuel_lbs = 0.0;
+
+    // 初始条件
+    double m_icLat_deg = 0.0, m_icLon_deg = 0.0, m_icAlt_m = 0.0, m_icHdg_deg = 0.0, m_icSpeed_kts = 0.0;
+
+    // --- 控制量 ---
+    double m_roll = 0.0;
+    double m_pitch = 0.0;
+    double m_throttle = 0.0;
+    bool m_gearDown = true;
+
+    // 用于输出的派生量
+    double m_load = 1.0;
+    double m_alpha_rad = 0.0;
+    double m_thrust_lbf = 0.0;
+    double m_gammaDot = 0.0;
+    double m_chiDot = 0.0;
+    double m_phiDot = 0.0;
+};
+
+#endif // POINT_MASS_MODEL_HPP
@@ -0,0 +1,177 @@
+// ScenarioFile.cpp
+#include "ScenarioFile.hpp"
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "JSBSimStateFields.hpp"
+
+namespace {
+
+std::string trim(const std::string& s) {
+    const std::size_t b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos) return std::string();
+    const std::size_t e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1);
+}
+
+// 注释须以 '#' 或 ';' 开始且位于行首或空白之后, 路径等值中的 '#'/';' 不被截断
+std::size_t commentStart(const std::string& line) {
+    for (std::size_t i = 0; i < line.size(); ++i) {
+        if ((line[i] == '#' || line[i] == ';') && (i == 0 || std::isspace(static_cast<unsigned char>(line[i - 1])))) return i;
+    }
+    return std::string::npos;
+}
+
+bool parseDouble(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return end != text.c_str() && trim(end).empty();
+}
+
+bool parseBool(const std::string& text, bool& value) {
+    if (text == "true" || text == "1" || text == "yes" || text == "down") { value = true; return true; }
+    if (text == "false" || text == "0" || text == "no" || text == "up") { value = false; return true; }
+    return false;
+}
+
+std::string baseName(const std::string& path) {
+    const std::size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    const std::size_t dot = name.rfind('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+} // namespace
+
+ControlFrame Scenario::controlsAt(double t) const {
+    ControlFrame frame;
+    // 基准帧给出所有通道的值, 控制段结束后不残留: 刹车松开, 减速板收起(0 表示保持, 故用 -1), 配平开关回中
+    frame.setRoll(0.0).setPitch(0.0).setRudder(0.0).setThrottles(throttle).setGearHandle(gear_down);
+    frame.setBrakes(0.0, 0.0).setSpeedBrakes(-1.0).setTrimSwitchRoll(0.0).setTrimSwitchPitch(0.0);
+    for (const ScenarioControl& c : controls) {
+        if (t >= c.t_start && t < c.t_end) frame.merge(c.controls);
+    }
+    return frame;
+}
+
+bool loadScenarioFile(const std::string& path, Scenario& scenario, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = path + ": cannot open file";
+        return false;
+    }
+
+    scenario = Scenario();
+    scenario.source_path = path;
+    scenario.name = baseName(path);
+
+    std::string section;
+    std::string line;
+    int line_no = 0;
+    auto fail = [&](const std::string& what) {
+        std::ostringstream ss;
+        ss << path << ":" << line_no << ": " << what;
+        error = ss.str();
+        return false;
+    };
+
+    while (std::getline(file, line)) {
+        ++line_no;
+        const std::size_t comment = commentStart(line);
+        line = trim(comment == std::string::npos ? line : line.substr(0, comment));
+        if (line.empty()) continue;
+
+        if (line.front() == '[') {
+            if (line.back() != ']') return fail("malformed section header");
+            section = trim(line.substr(1, line.size() - 2));
+            if (section == "control") scenario.controls.emplace_back();
+            else if (section != "scenario" && section != "initial") return fail("unknown section [" + section + "]");
+            continue;
+        }
+
+        const std::size_t eq = line.find('=');
+        if (eq == std::string::npos) return fail("expected key = value");
+        const std::string key = trim(line.substr(0, eq));
+        const std::string value = trim(line.substr(eq + 1));
+        double number = 0.0;
+        bool flag = false;
+        const bool is_number = parseDouble(value, number);
+
+        if (section == "scenario") {
+            if (key == "name") scenario.name = value;
+            else if (key == "aircraft") scenario.aircraft = value;
+            else if (key == "jsbsim_root") scenario.jsbsim_root = value;
+            else if (key == "output") {
+                std::istringstream fields(value);
+                std::string field;
+                while (std::getline(fields, field, ',')) {
+                    field = trim(field);
+                    if (field.empty()) continue;
+                    if (!findStateField(field).valid()) return fail("unknown output field '" + field + "'");
+                    scenario.output_fields.push_back(field);
+                }
+            } else if (!is_number) {
+                return fail("'" + key + "' expects a number");
+            } else if (key == "duration_s") scenario.duration_s = number;
+            else if (key == "dt") scenario.dt = number;
+            else if (key == "internal_rate_hz") scenario.internal_rate_hz = number;
+            else if (key == "output_rate_hz") scenario.output_rate_hz = number;
+            else return fail("unknown key '" + key + "' in [scenario]");
+        } else if (section == "initial") {
+            if (key == "gear_down") {
+                if (!parseBool(value, scenario.gear_down)) return fail("'gear_down' expects true/false");
+            } else if (!is_number) {
+                return fail("'" + key + "' expects a number");
+            } else if (key == "lat_deg") scenario.lat_deg = number;
+            else if (key == "lon_deg") scenario.lon_deg = number;
+            else if (key == "alt_m") scenario.alt_m = number;
+            else if (key == "hdg_deg") scenario.hdg_deg = number;
+            else if (key == "speed_kts") scenario.speed_kts = number;
+            else if (key == "throttle") scenario.throttle = number;
+            else return fail("unknown key '" + key + "' in [initial]");
+        } else if (section == "control") {
+            ScenarioControl& c = scenario.controls.back();
+            ControlFrame& f = c.controls;
+            if (key == "gear_down") {
+                if (!parseBool(value, flag)) return fail("'gear_down' expects true/false");
+                f.setGearHandle(flag);
+            } else if (!is_number) {
+                return fail("'" + key + "' expects a number");
+            } else if (key == "t_start") c.t_start = number;
+            else if (key == "t_end") c.t_end = number;
+            else if (key == "roll") f.setRoll(number);
+            else if (key == "pitch") f.setPitch(number);
+            else if (key == "rudder") f.setRudder(number);
+            else if (key == "throttle") f.setThrottles(number);
+            else if (key == "brake_left") f.setBrakes(number, f.brake_right);
+            else if (key == "brake_right") f.setBrakes(f.brake_left, number);
+            else if (key == "speed_brake") f.setSpeedBrakes(number);
+            else if (key == "trim_roll") f.setTrimSwitchRoll(number);
+            else if (key == "trim_pitch") f.setTrimSwitchPitch(number);
+            else return fail("unknown key '" + key + "' in [control]");
+        } else {
+            return fail("key outside of a section");
+        }
+    }
+
+    // --- 校验 ---
+    line_no = 0;
+    if (scenario.aircraft.empty()) return fail("missing [scenario] aircraft");
+    // 名称用作输出文件名, 不允许跳出输出目录
+    if (scenario.name.empty() || scenario.name == "." || scenario.name.find("..") != std::string::npos ||
+        scenario.name.find_first_of("/\\") != std::string::npos) {
+        return fail("invalid scenario name '" + scenario.name + "' (must be a plain file name)");
+    }
+    // 写成 !(x > 0) 使 NaN 同样被拒绝
+    if (!(scenario.dt > 0.0)) return fail("dt must be positive");
+    if (!(scenario.duration_s > 0.0)) return fail("duration_s must be positive");
+    for (const ScenarioControl& c : scenario.controls) {
+        if (!(c.t_end > c.t_start)) return fail("[control] t_end must be greater than t_start");
+    }
+    if (scenario.output_fields.empty()) {
+        scenario.output_fields = {"position_ned_x", "position_ned_y", "altitude_sl_m", "roll_rad", "pitch_rad", "yaw_rad",
+                                  "g_load", "calibrated_airspeed_kts"};
+    }
+    return true;
+}
@@ -0,0 +1,70 @@
+// ScenarioFile.hpp
+#ifndef SCENARIO_FILE_HPP
+#define SCENARIO_FILE_HPP
+
+#include <string>
+#include <vector>
+#include "ControlFrame.hpp"
+
+// --- 批处理场景文件 (INI格式) ---
+// 每个文件描述一个场景, 位于行首或空白之后的 '#' 或 ';' 开始注释(值中紧跟其他字符的 '#'/';' 保留):
+//
+//   [scenario]
+//   name = roll_left          ; 缺省为文件名(不含扩展名), 也是输出文件名; 不得含 '/'、'\\' 或 ".."
+//   aircraft = c172
+//   jsbsim_root = /path/to/jsbsim/data   ; 可由 batch_runner --root 覆盖
+//   duration_s = 60
+//   dt = 0.0166667
+//   internal_rate_hz = 0      ; >0 时启用多速率积分
+//   output_rate_hz = 10       ; 输出行频率, 0 表示每帧
+//   output = altitude_sl_m, roll_rad, g_load, engine0.thrust_lbf
+//
+//   [initial]
+//   lat_deg = 30.0
+//   lon_deg = 120.0
+//   alt_m = 3000
+//   hdg_deg = 90
+//   speed_kts = 250
+//   throttle = 0.8
+//   gear_down = false
+//
+//   [control]                 ; 可重复, 在 [t_start, t_end) 内施加; 省略 t_end 表示一直保持
+//   t_start = 5
+//   t_end = 15
+//   roll = 0.3                ; 另有 pitch, rudder, throttle, gear_down, brake_left, brake_right,
+//                             ; speed_brake, trim_roll, trim_pitch
+//
+// 杆舵量、刹车与配平开关在控制段之外回到0, 减速板收起; 油门、起落架在控制段结束后回到 [initial] 的值。
+// 同一时刻有多个控制段生效时, 按文件中的顺序依次覆盖。
+struct ScenarioControl {
+    double t_start = 0.0;
+    double t_end = 1e300;
+    ControlFrame controls;
+};
+
+struct Scenario {
+    std::string name;
+    std::string source_path;
+    std::string aircraft;
+    std::string jsbsim_root;
+
+    double duration_s = 60.0;
+    double dt = 1.0 / 60.0;
+    double internal_rate_hz = 0.0;
+    double output_rate_hz = 0.0;
+    std::vector<std::string> output_fields;
+
+    double lat_deg = 0.0, lon_deg = 0.0, alt_m = 1000.0, hdg_deg = 0.0, speed_kts = 100.0;
+    double throttle = 0.8;
+    bool gear_down = true;
+
+    std::vector<ScenarioControl> controls;
+
+    // 时刻 t 的完整控制输入: 基准(杆舵/刹车/配平开关归零、减速板收起、初始油门与起落架) + 所有生效控制段
+    ControlFrame controlsAt(double t) const;
+};
+
+// 读取并校验场景文件, 失败时 error 给出文件名、行号与原因
+bool loadScenarioFile(const std::string& path, Scenario& scenario, std::string& error);
+
+#endif // SCENARIO_FILE_HPP
@@ -0,0 +1,241 @@
+// SharedStateBus.cpp
+#include "SharedStateBus.hpp"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace shared_state {
+
+namespace {
+
+std::uint64_t alignUp(std::uint64_t n, std::uint64_t a) {
+    return (n + a - 1) / a * a;
+}
+
+std::uint64_t idsOffset() {
+    return sizeof(FrameHeader);
+}
+
+std::uint64_t statesOffset(std::uint32_t max_aircraft) {
+    return alignUp(idsOffset() + max_aircraft * sizeof(std::uint32_t), 64);
+}
+
+std::uint64_t frameStride(std::uint32_t max_aircraft) {
+    return alignUp(statesOffset(max_aircraft) + max_aircraft * sizeof(JSBSimAircraftState), 64);
+}
+
+std::string shmName(const std::string& name) {
+    return !name.empty() && name[0] == '/' ? name : "/" + name;
+}
+
+} // namespace
+
+std::size_t segmentBytes(std::uint32_t max_aircraft, std::uint32_t ring_frames) {
+    return static_cast<std::size_t>(sizeof(SegmentHeader) + ring_frames * frameStride(max_aircraft));
+}
+
+} // namespace shared_state
+
+using namespace shared_state;
+
+// --- SharedStateWriter ---
+
+SharedStateWriter::~SharedStateWriter() {
+    close();
+}
+
+bool SharedStateWriter::create(const std::string& name, std::uint32_t max_aircraft, std::uint32_t ring_frames) {
+    close();
+    if (max_aircraft == 0 || ring_frames < 2) {
+        std::cerr << "SharedStateWriter: need at least 1 aircraft and 2 ring frames" << std::endl;
+        return false;
+    }
+    m_name = shmName(name);
+    m_bytes = segmentBytes(max_aircraft, ring_frames);
+
+    ::shm_unlink(m_name.c_str());
+    const int fd = ::shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "SharedStateWriter: shm_open(" << m_name << ") failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(m_bytes)) != 0) {
+        std::cerr << "SharedStateWriter: ftruncate failed: " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        ::shm_unlink(m_name.c_str());
+        return false;
+    }
+    void* p = ::mmap(nullptr, m_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        std::cerr << "SharedStateWriter: mmap failed: " << std::strerror(errno) << std::endl;
+        ::shm_unlink(m_name.c_str());
+        return false;
+    }
+    m_base = static_cast<unsigned char*>(p);
+
+    // ftruncate 得到的页已清零; 原子量以定位 new 构造
+    m_header = new (m_base) SegmentHeader();
+    m_header->version = VERSION;
+    m_header->state_size = sizeof(JSBSimAircraftState);
+    m_header->max_aircraft = max_aircraft;
+    m_header->ring_frames = ring_frames;
+    m_header->frame_stride = frameStride(max_aircraft);
+    m_header->ids_offset = idsOffset();
+    m_header->states_offset = statesOffset(max_aircraft);
+    m_header->writer_pid = static_cast<std::uint32_t>(::getpid());
+    m_header->latest.store(0, std::memory_order_relaxed);
+    m_header->closed.store(0, std::memory_order_relaxed);
+    for (std::uint32_t k = 0; k < ring_frames; ++k) {
+        new (m_base + sizeof(SegmentHeader) + k * m_header->frame_stride) FrameHeader();
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(m_header->magic, MAGIC, sizeof(MAGIC));
+
+    m_writing = nullptr;
+    m_next = 1;
+    return true;
+}
+
+void SharedStateWriter::close(bool unlink) {
+    if (!m_base) return;
+    m_header->closed.store(1, std::memory_order_release);
+    ::munmap(m_base, m_bytes);
+    if (unlink) ::shm_unlink(m_name.c_str());
+    m_base = nullptr;
+    m_header = nullptr;
+    m_writing = nullptr;
+}
+
+unsigned char* SharedStateWriter::slotBase(std::uint64_t frame) const {
+    return m_base + sizeof(SegmentHeader) + (frame % m_header->ring_frames) * m_header->frame_stride;
+}
+
+JSBSimAircraftState* SharedStateWriter::beginFrame(double sim_time) {
+    if (!m_base) return nullptr;
+    unsigned char* base = slotBase(m_next);
+    m_writing = reinterpret_cast<FrameHeader*>(base);
+    m_writing->seq.store(2 * m_next + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_writing->sim_time = sim_time;
+
+    std::uint32_t* ids = reinterpret_cast<std::uint32_t*>(base + m_header->ids_offset);
+    for (std::uint32_t i = 0; i < m_header->max_aircraft; ++i) ids[i] = i;
+    return reinterpret_cast<JSBSimAircraftState*>(base + m_header->states_offset);
+}
+
+std::uint32_t* SharedStateWriter::frameIds() {
+    if (!m_writing) return nullptr;
+    return reinterpret_cast<std::uint32_t*>(reinterpret_cast<unsigned char*>(m_writing) + m_header->ids_offset);
+}
+
+void SharedStateWriter::setAircraft(std::uint32_t index, std::uint32_t id, const JSBSimAircraftState& state) {
+    if (!m_writing || index >= m_header->max_aircraft) return;
+    unsigned char* base = reinterpret_cast<unsigned char*>(m_writing);
+    reinterpret_cast<std::uint32_t*>(base + m_header->ids_offset)[index] = id;
+    std::memcpy(base + m_header->states_offset + index * sizeof(JSBSimAircraftState), &state, sizeof(JSBSimAircraftState));
+}
+
+void SharedStateWriter::publish(std::uint32_t count) {
+    if (!m_writing) return;
+    m_writing->count = count < m_header->max_aircraft ? count : m_header->max_aircraft;
+    m_writing->seq.store(2 * m_next, std::memory_order_release);
+    m_header->latest.store(m_next, std::memory_order_release);
+    m_writing = nullptr;
+    ++m_next;
+}
+
+// --- SharedStateReader ---
+
+SharedStateReader::~SharedStateReader() {
+    close();
+}
+
+bool SharedStateReader::open(const std::string& name) {
+    close();
+    const std::string shm = shmName(name);
+    const int fd = ::shm_open(shm.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(SegmentHeader)) {
+        ::close(fd);
+        return false;
+    }
+    m_bytes = static_cast<std::size_t>(st.st_size);
+    void* p = ::mmap(nullptr, m_bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return false;
+    m_base = static_cast<const unsigned char*>(p);
+    m_header = reinterpret_cast<const SegmentHeader*>(m_base);
+
+    if (std::memcmp(m_header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        close();
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_header->version != VERSION || m_header->state_size != sizeof(JSBSimAircraftState) ||
+        segmentBytes(m_header->max_aircraft, m_header->ring_frames) != m_bytes) {
+        std::cerr << "SharedStateReader: " << shm << " has an incompatible layout (version " << m_header->version
+                  << ", state size " << m_header->state_size << ")" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void SharedStateReader::close() {
+    if (!m_base) return;
+    ::munmap(const_cast<unsigned char*>(m_base), m_bytes);
+    m_base = nullptr;
+    m_header = nullptr;
+}
+
+const FrameHeader* SharedStateReader::slot(std::uint64_t frame) const {
+    return reinterpret_cast<const FrameHeader*>(m_base + sizeof(SegmentHeader) +
+                                                (frame % m_header->ring_frames) * m_header->frame_stride);
+}
+
+bool SharedStateReader::acquire(FrameView& view) const {
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        const std::uint64_t frame = latestFrame();
+        if (frame == 0) return false;
+        const FrameHeader* h = slot(frame);
+        if (h->seq.load(std::memory_order_acquire) != 2 * frame) continue; // 已被更新的帧改写
+        const unsigned char* base = reinterpret_cast<const unsigned char*>(h);
+        view.frame = frame;
+        view.sim_time = h->sim_time;
+        view.count = h->count;
+        view.ids = reinterpret_cast<const std::uint32_t*>(base + m_header->ids_offset);
+        view.states = reinterpret_cast<const JSBSimAircraftState*>(base + m_header->states_offset);
+        return true;
+    }
+    return false;
+}
+
+bool SharedStateReader::stillValid(const FrameView& view) const {
+    if (view.frame == 0) return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot(view.frame)->seq.load(std::memory_order_relaxed) == 2 * view.frame;
+}
+
+bool SharedStateReader::readLatest(double& sim_time, std::vector<std::uint32_t>& ids,
+                                   std::vector<JSBSimAircraftState>& states) const {
+    FrameView view;
+    for (int attempt = 0; attempt < 16; ++attempt) {
+        if (!acquire(view)) continue;
+        const std::uint32_t n = view.count < m_header->max_aircraft ? view.count : m_header->max_aircraft;
+        ids.assign(view.ids, view.ids + n);
+        states.resize(n);
+        if (n > 0) std::memcpy(static_cast<void*>(states.data()), view.states, n * sizeof(JSBSimAircraftState));
+        if (stillValid(view)) {
+            sim_time = view.sim_time;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,134 @@
+// SharedStateBus.hpp
+#ifndef SHARED_STATE_BUS_HPP
+#define SHARED_STATE_BUS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "JSBSimAircraftState.hpp"
+
+// --- 共享内存状态总线的段布局 ---
+// POSIX 共享内存段(shm_open), 同机的视景、教员台、分析进程映射后直接读取机群状态, 每帧无系统调用、无拷贝。
+// [段头 128字节][帧槽0][帧槽1]...[帧槽 ring_frames-1]
+// 每个帧槽: [帧头 64字节][ids: max_aircraft 个 uint32, 补齐到64字节][states: max_aircraft 个 JSBSimAircraftState]
+// 第 n 帧(从1开始)写入槽 n % ring_frames, 槽内以序列锁(seqlock)保护: 写入中 seq = 2n+1, 完成后 seq = 2n。
+// 状态按本机内存布局原样存放(JSBSimAircraftState 可平凡复制), 读写双方须为同一构建, 打开时以 state_size 校验。
+namespace shared_state {
+
+constexpr char MAGIC[8] = {'J', 'S', 'B', 'S', 'H', 'M', '0', '1'};
+constexpr std::uint32_t VERSION = 1;
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared-memory seqlock needs lock-free 64-bit atomics");
+
+struct SegmentHeader {
+    char magic[8];                          // 最后写入, 读者据此判断段已初始化
+    std::uint32_t version;
+    std::uint32_t state_size;               // sizeof(JSBSimAircraftState)
+    std::uint32_t max_aircraft;
+    std::uint32_t ring_frames;
+    std::uint64_t frame_stride;             // 每个帧槽的字节数
+    std::uint64_t ids_offset;               // 帧槽内 ids 的偏移
+    std::uint64_t states_offset;            // 帧槽内 states 的偏移
+    std::uint64_t reserved[2];
+    alignas(64) std::atomic<std::uint64_t> latest; // 最新完整帧号, 0 表示尚无
+    std::atomic<std::uint32_t> closed;      // 写进程关闭后置1
+    std::uint32_t writer_pid;
+};
+static_assert(sizeof(SegmentHeader) == 128, "SegmentHeader must be 128 bytes");
+
+struct FrameHeader {
+    std::atomic<std::uint64_t> seq;
+    double sim_time;
+    std::uint32_t count;                    // 本帧的飞机数
+    std::uint32_t reserved[11];
+};
+static_assert(sizeof(FrameHeader) == 64, "FrameHeader must be 64 bytes");
+
+// 段的总字节数
+std::size_t segmentBytes(std::uint32_t max_aircraft, std::uint32_t ring_frames);
+
+} // namespace shared_state
+
+// --- 写端 ---
+// 仿真进程创建段并逐帧发布。beginFrame() 返回本帧槽内的状态数组, 可直接写入(例如 FleetExecutor::forEach
+// 中各线程写各自的下标), 也可用 setAircraft() 逐架拷贝; publish() 结束本帧。
+// beginFrame()/publish() 须由同一线程成对调用。环中保留 ring_frames 帧, 读者零拷贝读取最新帧时,
+// 写端要再发布 ring_frames - 1 帧才会改写它。
+class SharedStateWriter {
+public:
+    SharedStateWriter() = default;
+    ~SharedStateWriter();
+
+    SharedStateWriter(const SharedStateWriter&) = delete;
+    SharedStateWriter& operator=(const SharedStateWriter&) = delete;
+
+    // name 形如 "/jsbsim_fleet"(缺少前导'/'时自动补上); 同名的旧段先删除
+    bool create(const std::string& name, std::uint32_t max_aircraft, std::uint32_t ring_frames = 8);
+    // 标记关闭并解除映射; unlink 为 true 时同时删除段(已映射的读者不受影响)
+    void close(bool unlink = true);
+    bool isOpen() const { return m_base != nullptr; }
+
+    JSBSimAircraftState* beginFrame(double sim_time);
+    void setAircraft(std::uint32_t index, std::uint32_t id, const JSBSimAircraftState& state);
+    // 写入中帧的 ids 数组(缺省为下标)
+    std::uint32_t* frameIds();
+    void publish(std::uint32_t count);
+
+    std::uint32_t maxAircraft() const { return m_header ? m_header->max_aircraft : 0; }
+    std::uint64_t framesPublished() const { return m_next - 1; }
+
+private:
+    unsigned char* slotBase(std::uint64_t frame) const;
+
+    std::string m_name;
+    unsigned char* m_base = nullptr;
+    std::size_t m_bytes = 0;
+    shared_state::SegmentHeader* m_header = nullptr;
+    shared_state::FrameHeader* m_writing = nullptr;
+    std::uint64_t m_next = 1;
+};
+
+// --- 读端 ---
+// 只读映射, 每帧读取只涉及共享内存访问。
+// 零拷贝: acquire() 取最新完整帧的视图, 读完后 stillValid() 确认期间未被改写(否则丢弃并重新 acquire());
+// 拷贝: readLatest() 在内部完成上述重试, 返回一致的副本。
+class SharedStateReader {
+public:
+    struct FrameView {
+        std::uint64_t frame = 0;
+        double sim_time = 0.0;
+        std::uint32_t count = 0;
+        const std::uint32_t* ids = nullptr;
+        const JSBSimAircraftState* states = nullptr;
+    };
+
+    SharedStateReader() = default;
+    ~SharedStateReader();
+
+    SharedStateReader(const SharedStateReader&) = delete;
+    SharedStateReader& operator=(const SharedStateReader&) = delete;
+
+    // 段不存在、尚未初始化或布局不符时返回 false, 可稍后重试
+    bool open(const std::string& name);
+    void close();
+    bool isOpen() const { return m_base != nullptr; }
+
+    std::uint32_t maxAircraft() const { return m_header->max_aircraft; }
+    std::uint64_t latestFrame() const { return m_header->latest.load(std::memory_order_acquire); }
+    bool writerClosed() const { return m_header->closed.load(std::memory_order_acquire) != 0; }
+
+    bool acquire(FrameView& view) const;
+    bool stillValid(const FrameView& view) const;
+    bool readLatest(double& sim_time, std::vector<std::uint32_t>& ids, std::vector<JSBSimAircraftState>& states) const;
+
+private:
+    const shared_state::FrameHeader* slot(std::uint64_t frame) const;
+
+    const unsigned char* m_base = nullptr;
+    std::size_t m_bytes = 0;
+    const shared_state::SegmentHeader* m_header = nullptr;
+};
+
+#endif // SHARED_STATE_BUS_HPP
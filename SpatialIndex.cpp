@@ -0,0 +1,362 @@
+// SpatialIndex.cpp
+#include "SpatialIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+std::int32_t cellCoord(double v, double cell_size) {
+    return static_cast<std::int32_t>(std::floor(v / cell_size));
+}
+
+// 坐标所在格, 限制在 [lo, hi] 内(查询范围可能远超 int32)
+std::int64_t clampedCell(double v, double cell_size, std::int64_t lo, std::int64_t hi) {
+    const double c = std::floor(v / cell_size);
+    if (c < static_cast<double>(lo)) return lo;
+    if (c > static_cast<double>(hi)) return hi;
+    return static_cast<std::int64_t>(c);
+}
+
+std::uint64_t packKey(std::int32_t ix, std::int32_t iy) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(ix)) << 32) | static_cast<std::uint32_t>(iy);
+}
+
+std::int32_t keyIx(std::uint64_t key) {
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(key >> 32));
+}
+
+std::int32_t keyIy(std::uint64_t key) {
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(key));
+}
+
+bool closer(const SpatialIndex::Hit& a, const SpatialIndex::Hit& b) {
+    return a.distance_m < b.distance_m;
+}
+
+const std::uint32_t NO_ID = static_cast<std::uint32_t>(-1);
+
+} // namespace
+
+// --- SpatialIndex ---
+
+SpatialIndex::SpatialIndex(const oe_base::batch::NedOrigin& origin, std::size_t max_aircraft, double cell_size_m)
+    : m_origin(origin), m_cellSize(cell_size_m > 0.0 ? cell_size_m : 2000.0)
+{
+    m_lat.assign(max_aircraft, 0.0);
+    m_lon.assign(max_aircraft, 0.0);
+    m_alt.assign(max_aircraft, 0.0);
+    m_active.assign(max_aircraft, 0);
+    for (Buffer& b : m_buffers) {
+        b.north.assign(max_aircraft, 0.0);
+        b.east.assign(max_aircraft, 0.0);
+        b.down.assign(max_aircraft, 0.0);
+        b.cell.assign(max_aircraft, 0);
+        b.cell_slot.assign(max_aircraft, 0);
+        b.present.assign(max_aircraft, 0);
+    }
+}
+
+void SpatialIndex::update(std::uint32_t id, const JSBSimAircraftState& state) {
+    update(id, state.position_ned.x(), state.position_ned.y(), state.altitude_sl_m);
+}
+
+void SpatialIndex::update(std::uint32_t id, double lat_deg, double lon_deg, double alt_m) {
+    if (id >= m_lat.size()) return;
+    m_lat[id] = lat_deg;
+    m_lon[id] = lon_deg;
+    m_alt[id] = alt_m;
+    m_active[id] = 1;
+}
+
+void SpatialIndex::remove(std::uint32_t id) {
+    if (id < m_active.size()) m_active[id] = 0;
+}
+
+std::uint64_t SpatialIndex::cellKey(double north, double east) const {
+    return packKey(cellCoord(north, m_cellSize), cellCoord(east, m_cellSize));
+}
+
+void SpatialIndex::insert(Buffer& b, std::uint32_t id, std::uint64_t key) {
+    std::vector<std::uint32_t>& ids = b.cells[key];
+    b.cell[id] = key;
+    b.cell_slot[id] = static_cast<std::uint32_t>(ids.size());
+    b.present[id] = 1;
+    ids.push_back(id);
+    ++b.count;
+}
+
+// 与格内最后一个交换后删除, 空格随之删除
+void SpatialIndex::erase(Buffer& b, std::uint32_t id) {
+    auto it = b.cells.find(b.cell[id]);
+    std::vector<std::uint32_t>& ids = it->second;
+    const std::uint32_t slot = b.cell_slot[id];
+    const std::uint32_t last = ids.back();
+    ids[slot] = last;
+    b.cell_slot[last] = slot;
+    ids.pop_back();
+    if (ids.empty()) b.cells.erase(it);
+    b.present[id] = 0;
+    --b.count;
+}
+
+std::size_t SpatialIndex::commit(double sim_time) {
+    const int back = 1 - m_front.load(std::memory_order_relaxed);
+    Buffer& b = m_buffers[back];
+    while (b.readers.load() != 0) std::this_thread::yield();
+
+    const std::size_t n = m_lat.size();
+    oe_base::batch::geodeticToNed(m_origin, m_lat.data(), m_lon.data(), m_alt.data(),
+                                  b.north.data(), b.east.data(), b.down.data(), n);
+
+    // 该份缓冲上一次的格归属是两帧之前的, 只有跨格的飞机需要移动
+    std::size_t moved = 0;
+    bool any = false;
+    std::int32_t min_ix = 0, max_ix = -1, min_iy = 0, max_iy = -1;
+    for (std::uint32_t id = 0; id < n; ++id) {
+        if (!m_active[id]) {
+            if (b.present[id]) {
+                erase(b, id);
+                ++moved;
+            }
+            continue;
+        }
+        const std::uint64_t key = cellKey(b.north[id], b.east[id]);
+        if (!b.present[id]) {
+            insert(b, id, key);
+            ++moved;
+        } else if (b.cell[id] != key) {
+            erase(b, id);
+            insert(b, id, key);
+            ++moved;
+        }
+
+        const std::int32_t ix = keyIx(key), iy = keyIy(key);
+        if (!any) {
+            min_ix = max_ix = ix;
+            min_iy = max_iy = iy;
+            any = true;
+        } else {
+            min_ix = std::min(min_ix, ix);
+            max_ix = std::max(max_ix, ix);
+            min_iy = std::min(min_iy, iy);
+            max_iy = std::max(max_iy, iy);
+        }
+    }
+    b.min_ix = min_ix;
+    b.max_ix = max_ix;
+    b.min_iy = min_iy;
+    b.max_iy = max_iy;
+    b.frame = ++m_frame;
+    b.sim_time = sim_time;
+
+    m_front.store(back);
+    return moved;
+}
+
+// 读者先登记再确认仍是发布帧: 若期间发布帧已切换则撤销重试, 保证 commit() 等待读者时不会漏掉
+SpatialIndex::View SpatialIndex::acquire() const {
+    for (;;) {
+        const int front = m_front.load();
+        const Buffer& b = m_buffers[front];
+        b.readers.fetch_add(1);
+        if (m_front.load() == front) return View(&b, m_cellSize);
+        b.readers.fetch_sub(1);
+    }
+}
+
+// --- SpatialIndex::View ---
+
+SpatialIndex::View& SpatialIndex::View::operator=(View&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_buffer = other.m_buffer;
+        m_cellSize = other.m_cellSize;
+        other.m_buffer = nullptr;
+    }
+    return *this;
+}
+
+void SpatialIndex::View::release() {
+    if (!m_buffer) return;
+    m_buffer->readers.fetch_sub(1, std::memory_order_release);
+    m_buffer = nullptr;
+}
+
+bool SpatialIndex::View::contains(std::uint32_t id) const {
+    return m_buffer && id < m_buffer->present.size() && m_buffer->present[id];
+}
+
+bool SpatialIndex::View::position(std::uint32_t id, double& north, double& east, double& down) const {
+    if (!contains(id)) return false;
+    north = m_buffer->north[id];
+    east = m_buffer->east[id];
+    down = m_buffer->down[id];
+    return true;
+}
+
+void SpatialIndex::View::radius(double north, double east, double down, double radius_m, std::vector<Hit>& out) const {
+    radiusImpl(north, east, down, radius_m, NO_ID, out);
+}
+
+void SpatialIndex::View::radius(std::uint32_t id, double radius_m, std::vector<Hit>& out) const {
+    out.clear();
+    double n, e, d;
+    if (position(id, n, e, d)) radiusImpl(n, e, d, radius_m, id, out);
+}
+
+void SpatialIndex::View::radiusImpl(double north, double east, double down, double radius_m, std::uint32_t exclude,
+                                    std::vector<Hit>& out) const {
+    out.clear();
+    if (!m_buffer || m_buffer->count == 0 || radius_m < 0.0) return;
+    const Buffer& b = *m_buffer;
+    const double r2 = radius_m * radius_m;
+
+    auto scan = [&](const std::vector<std::uint32_t>& ids) {
+        for (std::uint32_t id : ids) {
+            if (id == exclude) continue;
+            const double dn = b.north[id] - north, de = b.east[id] - east, dd = b.down[id] - down;
+            const double d2 = dn * dn + de * de + dd * dd;
+            if (d2 <= r2) out.push_back({id, std::sqrt(d2)});
+        }
+    };
+
+    // 覆盖的格限制在占用范围内; 仍多于占用格数时直接遍历占用格
+    const std::int64_t ix0 = clampedCell(north - radius_m, m_cellSize, b.min_ix, b.max_ix + 1);
+    const std::int64_t ix1 = clampedCell(north + radius_m, m_cellSize, b.min_ix - 1, b.max_ix);
+    const std::int64_t iy0 = clampedCell(east - radius_m, m_cellSize, b.min_iy, b.max_iy + 1);
+    const std::int64_t iy1 = clampedCell(east + radius_m, m_cellSize, b.min_iy - 1, b.max_iy);
+    if (ix0 > ix1 || iy0 > iy1) return;
+    if (static_cast<double>(ix1 - ix0 + 1) * static_cast<double>(iy1 - iy0 + 1) > static_cast<double>(b.cells.size())) {
+        for (const auto& cell : b.cells) scan(cell.second);
+        return;
+    }
+    for (std::int64_t ix = ix0; ix <= ix1; ++ix) {
+        for (std::int64_t iy = iy0; iy <= iy1; ++iy) {
+            auto it = b.cells.find(packKey(static_cast<std::int32_t>(ix), static_cast<std::int32_t>(iy)));
+            if (it != b.cells.end()) scan(it->second);
+        }
+    }
+}
+
+void SpatialIndex::View::nearest(double north, double east, double down, std::size_t k, std::vector<Hit>& out,
+                                 double max_range_m) const {
+    nearestImpl(north, east, down, k, max_range_m, NO_ID, out);
+}
+
+void SpatialIndex::View::nearest(std::uint32_t id, std::size_t k, std::vector<Hit>& out, double max_range_m) const {
+    out.clear();
+    double n, e, d;
+    if (position(id, n, e, d)) nearestImpl(n, e, d, k, max_range_m, id, out);
+}
+
+// 由中心格向外逐圈搜索, out 作为按距离的大顶堆保留当前最近的 k 个;
+// 第 ring 圈之外的格与查询点的水平距离至少为 ring * cell_size 加上点到中心格边界的距离, 堆满且堆顶不超过该值时停止
+void SpatialIndex::View::nearestImpl(double north, double east, double down, std::size_t k, double max_range_m,
+                                     std::uint32_t exclude, std::vector<Hit>& out) const {
+    out.clear();
+    if (!m_buffer || m_buffer->count == 0 || k == 0) return;
+    const Buffer& b = *m_buffer;
+    const double max_range2 = max_range_m * max_range_m;
+    const std::int32_t cx = cellCoord(north, m_cellSize), cy = cellCoord(east, m_cellSize);
+
+    auto scan = [&](const std::vector<std::uint32_t>& ids) {
+        for (std::uint32_t id : ids) {
+            if (id == exclude) continue;
+            const double dn = b.north[id] - north, de = b.east[id] - east, dd = b.down[id] - down;
+            const double d2 = dn * dn + de * de + dd * dd;
+            if (d2 > max_range2) continue;
+            const Hit hit{id, std::sqrt(d2)};
+            if (out.size() < k) {
+                out.push_back(hit);
+                std::push_heap(out.begin(), out.end(), closer);
+            } else if (hit.distance_m < out.front().distance_m) {
+                std::pop_heap(out.begin(), out.end(), closer);
+                out.back() = hit;
+                std::push_heap(out.begin(), out.end(), closer);
+            }
+        }
+    };
+    auto visit = [&](std::int64_t ix, std::int64_t iy) {
+        if (ix < b.min_ix || ix > b.max_ix || iy < b.min_iy || iy > b.max_iy) return;
+        auto it = b.cells.find(packKey(static_cast<std::int32_t>(ix), static_cast<std::int32_t>(iy)));
+        if (it != b.cells.end()) scan(it->second);
+    };
+
+    // 查询点到中心格边界的最近距离
+    const double inset = std::min({north - cx * m_cellSize, (cx + 1) * m_cellSize - north,
+                                   east - cy * m_cellSize, (cy + 1) * m_cellSize - east});
+
+    // 占用范围的所有格都已在圈内时不必继续
+    const std::int64_t max_ring = std::max({std::int64_t(cx) - b.min_ix, std::int64_t(b.max_ix) - cx,
+                                            std::int64_t(cy) - b.min_iy, std::int64_t(b.max_iy) - cy});
+    for (std::int64_t ring = 0; ring <= max_ring; ++ring) {
+        if (ring == 0) {
+            visit(cx, cy);
+        } else {
+            for (std::int64_t d = -ring; d <= ring; ++d) {
+                visit(cx - ring, cy + d);
+                visit(cx + ring, cy + d);
+            }
+            for (std::int64_t d = -ring + 1; d <= ring - 1; ++d) {
+                visit(cx + d, cy - ring);
+                visit(cx + d, cy + ring);
+            }
+        }
+        const double reach = static_cast<double>(ring) * m_cellSize + inset;
+        if (reach > max_range_m) break;
+        if (out.size() == k && out.front().distance_m <= reach) break;
+    }
+    std::sort_heap(out.begin(), out.end(), closer);
+}
+
+// 每个占用格与自身及"前半平面"的邻格配对, 每对格只比较一次;
+// 邻格范围限制在占用范围内, 仍多于占用格数时改为遍历占用格
+void SpatialIndex::View::pairsWithin(double distance_m, std::vector<Pair>& out) const {
+    out.clear();
+    if (!m_buffer || m_buffer->count < 2 || !(distance_m >= 0.0)) return;
+    const Buffer& b = *m_buffer;
+    const double r2 = distance_m * distance_m;
+    // 超过占用范围的跨度没有意义, 先截断再转换为整数, 距离很大或为无穷时也不会溢出
+    const std::int64_t span = std::max(std::int64_t(b.max_ix) - b.min_ix, std::int64_t(b.max_iy) - b.min_iy);
+    const double reach_cells = std::ceil(distance_m / m_cellSize);
+    const std::int64_t reach = reach_cells < static_cast<double>(span) ? static_cast<std::int64_t>(reach_cells) : span;
+
+    auto test = [&](std::uint32_t i, std::uint32_t j) {
+        const double dn = b.north[i] - b.north[j], de = b.east[i] - b.east[j], dd = b.down[i] - b.down[j];
+        const double d2 = dn * dn + de * de + dd * dd;
+        if (d2 <= r2) out.push_back({std::min(i, j), std::max(i, j), std::sqrt(d2)});
+    };
+    auto testCells = [&](const std::vector<std::uint32_t>& a, const std::vector<std::uint32_t>& c) {
+        for (std::uint32_t i : a) {
+            for (std::uint32_t j : c) test(i, j);
+        }
+    };
+
+    for (const auto& cell : b.cells) {
+        const std::vector<std::uint32_t>& ids = cell.second;
+        for (std::size_t p = 0; p < ids.size(); ++p) {
+            for (std::size_t q = p + 1; q < ids.size(); ++q) test(ids[p], ids[q]);
+        }
+        const std::int64_t ix = keyIx(cell.first), iy = keyIy(cell.first);
+        const std::int64_t dx1 = std::min(reach, std::int64_t(b.max_ix) - ix);
+        const std::int64_t dy0 = std::max(-reach, std::int64_t(b.min_iy) - iy);
+        const std::int64_t dy1 = std::min(reach, std::int64_t(b.max_iy) - iy);
+
+        if (static_cast<double>(dx1 + 1) * static_cast<double>(dy1 - dy0 + 1) > static_cast<double>(b.cells.size())) {
+            for (const auto& other : b.cells) {
+                const std::int64_t dx = keyIx(other.first) - ix, dy = keyIy(other.first) - iy;
+                if (dx < 0 || (dx == 0 && dy <= 0) || dx > reach || dy < -reach || dy > reach) continue;
+                testCells(ids, other.second);
+            }
+            continue;
+        }
+        for (std::int64_t dx = 0; dx <= dx1; ++dx) {
+            for (std::int64_t dy = dy0; dy <= dy1; ++dy) {
+                if (dx == 0 && dy <= 0) continue;
+                auto it = b.cells.find(packKey(static_cast<std::int32_t>(ix + dx), static_cast<std::int32_t>(iy + dy)));
+                if (it != b.cells.end()) testCells(ids, it->second);
+            }
+        }
+    }
+}
@@ -0,0 +1,136 @@
+// SpatialIndex.hpp
+#ifndef SPATIAL_INDEX_HPP
+#define SPATIAL_INDEX_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "JSBSimAircraftState.hpp"
+#include "OeBase.hpp"
+
+// --- 机群位置的空间索引 ---
+// 以场景原点的本地北-东-地坐标为准, 水平方向划分为边长 cell_size_m 的均匀网格(哈希格, 不限范围),
+// 每格保存落在该格内的飞机ID。用于防撞、传感器探测、武器飞出等逐帧的近距查询, 代替 O(N^2) 的两两比较。
+//
+// 写端(仿真线程):
+//   1. 每架飞机在 update() 之后调用 update(id, getState()), 可在 FleetExecutor::forEach() 的工作线程上
+//      各自写入(不同ID互不干扰);
+//   2. 帧边界调用一次 commit(): 批量换算本地坐标, 只移动跨格的飞机(增量维护), 然后发布新帧。
+// 读端(任意线程, 可多个): acquire() 取得最近一次 commit() 的只读视图, 在下一帧推进期间查询。
+// 内部双缓冲: commit() 写入未发布的一份, 若该份仍被两帧之前的视图持有则等待其释放, 因此视图不应跨越多帧保留。
+class SpatialIndex {
+public:
+    struct Hit {
+        std::uint32_t id = 0;
+        double distance_m = 0.0;
+    };
+
+    struct Pair {
+        std::uint32_t a = 0; // a < b
+        std::uint32_t b = 0;
+        double distance_m = 0.0;
+    };
+
+private:
+    struct Buffer {
+        std::vector<double> north, east, down;
+        std::vector<std::uint64_t> cell;      // 所在格键
+        std::vector<std::uint32_t> cell_slot; // 在格内列表中的下标
+        std::vector<std::uint8_t> present;
+        std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> cells;
+        std::size_t count = 0;
+        std::int32_t min_ix = 0, max_ix = -1, min_iy = 0, max_iy = -1; // 占用格的范围
+        std::uint64_t frame = 0;
+        double sim_time = 0.0;
+        alignas(64) mutable std::atomic<int> readers{0}; // 持有该帧视图的读者数
+    };
+
+public:
+    // --- 只读视图 ---
+    // 持有期间对应的一帧不会被改写; 所有查询的输出向量先清空再填充, 容量足够时不分配内存
+    class View {
+    public:
+        View() = default;
+        ~View() { release(); }
+        View(View&& other) noexcept : m_buffer(other.m_buffer), m_cellSize(other.m_cellSize) { other.m_buffer = nullptr; }
+        View& operator=(View&& other) noexcept;
+        View(const View&) = delete;
+        View& operator=(const View&) = delete;
+
+        bool valid() const { return m_buffer != nullptr; }
+        void release();
+
+        std::uint64_t frame() const { return m_buffer ? m_buffer->frame : 0; }
+        double simTime() const { return m_buffer ? m_buffer->sim_time : 0.0; }
+        std::size_t size() const { return m_buffer ? m_buffer->count : 0; }
+        bool contains(std::uint32_t id) const;
+        // 本地北-东-地坐标(米); 不在索引中返回 false
+        bool position(std::uint32_t id, double& north, double& east, double& down) const;
+
+        // 与给定点距离不超过 radius_m 的飞机, 按ID所在格的顺序(未排序)
+        void radius(double north, double east, double down, double radius_m, std::vector<Hit>& out) const;
+        // 以某架飞机为中心, 结果不含其自身
+        void radius(std::uint32_t id, double radius_m, std::vector<Hit>& out) const;
+
+        // 最近的 k 架飞机, 按距离升序; max_range_m 限制搜索半径
+        void nearest(double north, double east, double down, std::size_t k, std::vector<Hit>& out,
+                     double max_range_m = 1e30) const;
+        void nearest(std::uint32_t id, std::size_t k, std::vector<Hit>& out, double max_range_m = 1e30) const;
+
+        // 所有距离不超过 distance_m 的飞机对, 每对只出现一次
+        void pairsWithin(double distance_m, std::vector<Pair>& out) const;
+
+    private:
+        friend class SpatialIndex;
+        View(const Buffer* buffer, double cell_size) : m_buffer(buffer), m_cellSize(cell_size) {}
+
+        void radiusImpl(double north, double east, double down, double radius_m, std::uint32_t exclude,
+                        std::vector<Hit>& out) const;
+        void nearestImpl(double north, double east, double down, std::size_t k, double max_range_m,
+                         std::uint32_t exclude, std::vector<Hit>& out) const;
+
+        const Buffer* m_buffer = nullptr;
+        double m_cellSize = 1.0;
+    };
+
+    // max_aircraft 为ID上限(ID取值 [0, max_aircraft)), 构造时一次分配所有逐机数组
+    SpatialIndex(const oe_base::batch::NedOrigin& origin, std::size_t max_aircraft, double cell_size_m = 2000.0);
+    SpatialIndex(const SpatialIndex&) = delete;
+    SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+    // --- 写端 ---
+    // 记录一架飞机本帧的位置(position_ned.x/y 为纬度/经度, 高度取 altitude_sl_m); 超出ID上限时忽略
+    void update(std::uint32_t id, const JSBSimAircraftState& state);
+    void update(std::uint32_t id, double lat_deg, double lon_deg, double alt_m);
+    // 下一次 commit() 起从索引中移除
+    void remove(std::uint32_t id);
+    // 发布本帧; 返回本次跨格移动(含加入与移除)的飞机数
+    std::size_t commit(double sim_time = 0.0);
+
+    // --- 读端 ---
+    View acquire() const;
+
+    std::size_t capacity() const { return m_lat.size(); }
+    double cellSize() const { return m_cellSize; }
+    const oe_base::batch::NedOrigin& origin() const { return m_origin; }
+
+private:
+    std::uint64_t cellKey(double north, double east) const;
+    static void insert(Buffer& b, std::uint32_t id, std::uint64_t key);
+    static void erase(Buffer& b, std::uint32_t id);
+
+    oe_base::batch::NedOrigin m_origin;
+    double m_cellSize;
+
+    // 写端暂存: 每帧 update() 写入, commit() 读取
+    std::vector<double> m_lat, m_lon, m_alt;
+    std::vector<std::uint8_t> m_active;
+
+    Buffer m_buffers[2];
+    std::atomic<int> m_front{0};
+    std::uint64_t m_frame = 0;
+};
+
+#endif // SPATIAL_INDEX_HPP
@@ -0,0 +1,111 @@
+// StateHistory.hpp
+#ifndef STATE_HISTORY_HPP
+#define STATE_HISTORY_HPP
+
+#include <cstddef>
+#include <vector>
+#include "JSBSimAircraftState.hpp"
+#include "StateInterpolation.hpp"
+
+// --- 按仿真时间索引的状态历史环 ---
+// 每架飞机一个: 仿真线程每帧 record(仿真时间, getState()), 传感器、数据链、视景等各自按自己的
+// 采样率和延迟调用 stateAt(t) 取过去某一时刻的插值状态, 不必各存一份。
+// 容量在构造时一次分配, 之后 record() 只做一次定长状态拷贝; 写满后覆盖最旧的一帧。
+// 按时间查找先用平均帧间隔估算下标, 再就近修正: 定步长时为 O(1), 变步长时只多走几格。
+// 非线程安全: record() 与查询应在同一线程(或由调用方加锁)。
+class StateHistory {
+public:
+    explicit StateHistory(std::size_t depth = 600) { setDepth(depth); }
+
+    // 重新分配并清空
+    void setDepth(std::size_t depth) {
+        m_depth = depth > 2 ? depth : 2;
+        m_times.assign(m_depth, 0.0);
+        m_states.assign(m_depth, JSBSimAircraftState());
+        clear();
+    }
+
+    void clear() {
+        m_head = 0;
+        m_count = 0;
+    }
+
+    // 时间须递增; 与上一帧同一时刻时覆盖上一帧, 时间倒退(RunIC、载入检查点)时先清空历史
+    void record(double sim_time, const JSBSimAircraftState& state) {
+        if (m_count > 0) {
+            const double newest = newestTime();
+            if (sim_time == newest) {
+                m_states[slot(m_count - 1)] = state;
+                return;
+            }
+            if (sim_time < newest) clear();
+        }
+        std::size_t i;
+        if (m_count < m_depth) {
+            i = slot(m_count);
+            ++m_count;
+        } else {
+            i = m_head;
+            m_head = m_head + 1 == m_depth ? 0 : m_head + 1;
+        }
+        m_times[i] = sim_time;
+        m_states[i] = state;
+    }
+
+    // --- 查询 ---
+    std::size_t size() const { return m_count; }
+    std::size_t depth() const { return m_depth; }
+    bool empty() const { return m_count == 0; }
+    double oldestTime() const { return m_times[slot(0)]; }
+    double newestTime() const { return m_times[slot(m_count - 1)]; }
+
+    // age = 0 为最新一帧, 须小于 size()
+    const JSBSimAircraftState& frame(std::size_t age) const { return m_states[slot(m_count - 1 - age)]; }
+    double frameTime(std::size_t age) const { return m_times[slot(m_count - 1 - age)]; }
+
+    // 时刻 t 的状态: 在相邻两帧之间插值(位置、速度等线性, 姿态 slerp)。
+    // t 在 [oldestTime(), newestTime()] 之外时返回 false, clamp 为 true 时改为取最近的端点帧
+    bool stateAt(double t, JSBSimAircraftState& out, bool clamp = false) const {
+        if (m_count == 0) return false;
+        if (t <= oldestTime() || t >= newestTime()) {
+            const bool before = t <= oldestTime();
+            if (!clamp && t != (before ? oldestTime() : newestTime())) return false;
+            out = m_states[slot(before ? 0 : m_count - 1)];
+            return true;
+        }
+
+        const std::size_t k = lowerIndex(t);
+        const std::size_t ia = slot(k), ib = slot(k + 1);
+        const double span = m_times[ib] - m_times[ia];
+        const double f = span > 0.0 ? (t - m_times[ia]) / span : 0.0;
+        state_interp::interpolate(m_states[ia], m_states[ib], f, out);
+        state_interp::slerpAttitude(m_states[ia], m_states[ib], f, out.roll_rad, out.pitch_rad, out.yaw_rad);
+        return true;
+    }
+
+private:
+    // 第 k 旧的帧(0 为最旧)在存储中的位置
+    std::size_t slot(std::size_t k) const {
+        const std::size_t i = m_head + k;
+        return i >= m_depth ? i - m_depth : i;
+    }
+
+    // 满足 time(k) <= t < time(k + 1) 的 k, 要求 oldestTime() < t < newestTime()
+    std::size_t lowerIndex(double t) const {
+        const double t0 = oldestTime();
+        const double mean_dt = (newestTime() - t0) / static_cast<double>(m_count - 1);
+        std::size_t k = static_cast<std::size_t>((t - t0) / mean_dt);
+        if (k > m_count - 2) k = m_count - 2;
+        while (k > 0 && m_times[slot(k)] > t) --k;
+        while (k + 2 < m_count && m_times[slot(k + 1)] <= t) ++k;
+        return k;
+    }
+
+    std::vector<double> m_times;
+    std::vector<JSBSimAircraftState> m_states;
+    std::size_t m_depth = 0;
+    std::size_t m_head = 0;  // 最旧一帧的位置
+    std::size_t m_count = 0;
+};
+
+#endif // STATE_HISTORY_HPP
@@ -0,0 +1,103 @@
+// StateInterpolation.hpp
+#ifndef STATE_INTERPOLATION_HPP
+#define STATE_INTERPOLATION_HPP
+
+#include <cmath>
+#include "JSBSimAircraftState.hpp"
+
+// --- 状态插值 ---
+// 在两帧状态之间按比例 t (0 = a, 1 = b) 线性插值。
+// 滚转/偏航角与经度按最短路径插值, 避免在 ±PI / ±180 处跳变; 离散量(on_ground)取较近的一帧。
+namespace state_interp {
+
+inline double lerp(double a, double b, double t) {
+    return a + (b - a) * t;
+}
+
+inline double lerpAngleRad(double a, double b, double t) {
+    return oe_base::aepcdRad(a + oe_base::aepcdRad(b - a) * t);
+}
+
+inline double lerpAngleDeg(double a, double b, double t) {
+    return oe_base::aepcdDeg(a + oe_base::aepcdDeg(b - a) * t);
+}
+
+inline oe_base::Vec3d lerp(const oe_base::Vec3d& a, const oe_base::Vec3d& b, double t) {
+    return oe_base::Vec3d(lerp(a.x(), b.x(), t), lerp(a.y(), b.y(), t), lerp(a.z(), b.z(), t));
+}
+
+// 姿态按四元数球面插值(slerp): 大角度或接近 ±90° 俯仰时仍沿最短旋转, 不会像逐个欧拉角插值那样绕远路。
+// 偏航沿用输入的取值范围(两端都非负时结果在 [0, 2PI))
+inline void slerpAttitude(const JSBSimAircraftState& a, const JSBSimAircraftState& b, double t,
+                          double& roll_rad, double& pitch_rad, double& yaw_rad) {
+    const double roll[2] = {a.roll_rad, b.roll_rad};
+    const double pitch[2] = {a.pitch_rad, b.pitch_rad};
+    const double yaw[2] = {a.yaw_rad, b.yaw_rad};
+    double qw[2], qx[2], qy[2], qz[2];
+    oe_base::batch::eulerToQuat(roll, pitch, yaw, qw, qx, qy, qz, 2);
+
+    double dot = qw[0] * qw[1] + qx[0] * qx[1] + qy[0] * qy[1] + qz[0] * qz[1];
+    double sign = 1.0;
+    if (dot < 0.0) { dot = -dot; sign = -1.0; } // q 与 -q 表示同一姿态, 取近的一侧
+    double wa = 1.0 - t, wb = t;
+    if (dot < 0.9995) {
+        const double theta = std::acos(dot);
+        const double inv_sin = 1.0 / std::sin(theta);
+        wa = std::sin((1.0 - t) * theta) * inv_sin;
+        wb = std::sin(t * theta) * inv_sin;
+    }
+    wb *= sign;
+    double w = wa * qw[0] + wb * qw[1], x = wa * qx[0] + wb * qx[1];
+    double y = wa * qy[0] + wb * qy[1], z = wa * qz[0] + wb * qz[1];
+    const double inv_norm = 1.0 / std::sqrt(w * w + x * x + y * y + z * z);
+    w *= inv_norm; x *= inv_norm; y *= inv_norm; z *= inv_norm;
+
+    oe_base::batch::quatToEuler(&w, &x, &y, &z, &roll_rad, &pitch_rad, &yaw_rad, 1);
+    if (yaw_rad < 0.0 && a.yaw_rad >= 0.0 && b.yaw_rad >= 0.0) yaw_rad += 2.0 * oe_base::PI;
+}
+
+// out 不能与 a 或 b 是同一个对象
+inline void interpolate(const JSBSimAircraftState& a, const JSBSimAircraftState& b, double t, JSBSimAircraftState& out) {
+    // position_ned 存放 (纬度, 经度, 高度)
+    out.position_ned.set(lerp(a.position_ned.x(), b.position_ned.x(), t),
+                         lerpAngleDeg(a.position_ned.y(), b.position_ned.y(), t),
+                         lerp(a.position_ned.z(), b.position_ned.z(), t));
+    out.velocity_ned = lerp(a.velocity_ned, b.velocity_ned, t);
+    out.accel_ned = lerp(a.accel_ned, b.accel_ned, t);
+    out.altitude_sl_m = lerp(a.altitude_sl_m, b.altitude_sl_m, t);
+
+    out.roll_rad = lerpAngleRad(a.roll_rad, b.roll_rad, t);
+    out.pitch_rad = lerp(a.pitch_rad, b.pitch_rad, t);
+    out.yaw_rad = lerpAngleRad(a.yaw_rad, b.yaw_rad, t);
+    out.ang_vel_rps = lerp(a.ang_vel_rps, b.ang_vel_rps, t);
+
+    out.g_load = lerp(a.g_load, b.g_load, t);
+    out.mach = lerp(a.mach, b.mach, t);
+    out.alpha_rad = lerp(a.alpha_rad, b.alpha_rad, t);
+    out.beta_rad = lerp(a.beta_rad, b.beta_rad, t);
+    out.flight_path_rad = lerp(a.flight_path_rad, b.flight_path_rad, t);
+    out.calibrated_airspeed_kts = lerp(a.calibrated_airspeed_kts, b.calibrated_airspeed_kts, t);
+
+    out.total_weight_lbs = lerp(a.total_weight_lbs, b.total_weight_lbs, t);
+    out.fuel_weight_lbs = lerp(a.fuel_weight_lbs, b.fuel_weight_lbs, t);
+    out.on_ground = t < 0.5 ? a.on_ground : b.on_ground;
+
+    out.num_engines = b.num_engines;
+    out.propulsion.resize(b.propulsion.size());
+    for (std::size_t i = 0; i < b.propulsion.size(); ++i) {
+        const PropulsionState& pb = b.propulsion[i];
+        if (i >= a.propulsion.size()) {
+            out.propulsion[i] = pb;
+            continue;
+        }
+        const PropulsionState& pa = a.propulsion[i];
+        out.propulsion[i].thrust_lbf = lerp(pa.thrust_lbf, pb.thrust_lbf, t);
+        out.propulsion[i].rpm = lerp(pa.rpm, pb.rpm, t);
+        out.propulsion[i].fuel_flow_pph = lerp(pa.fuel_flow_pph, pb.fuel_flow_pph, t);
+        out.propulsion[i].pla_pct = lerp(pa.pla_pct, pb.pla_pct, t);
+    }
+}
+
+} // namespace state_interp
+
+#endif // STATE_INTERPOLATION_HPP
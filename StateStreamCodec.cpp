@@ -0,0 +1,414 @@
+// StateStreamCodec.cpp
+#include "StateStreamCodec.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include "JSBSimStateFields.hpp"
+
+namespace state_stream {
+
+namespace {
+
+constexpr std::uint8_t PACKET_MAGIC = 0x5A;
+constexpr std::uint8_t PACKET_VERSION = 2;
+
+constexpr std::uint8_t FLAG_KEYFRAME = 0x1;
+constexpr std::uint8_t FLAG_REMOVE = 0x2;
+
+// 循环量的差值与取值范围
+double wrapDiff(int c, double d) {
+    if (c == Roll || c == Yaw) return oe_base::wrapRad(d);
+    if (c == PosY) return oe_base::wrapDeg(d);
+    return d;
+}
+
+double normalize(int c, double v) {
+    if (c == Roll) return oe_base::wrapRad(v);
+    if (c == Yaw) {
+        const double w = oe_base::wrapRad(v);
+        return w < 0.0 ? w + 2.0 * oe_base::PI : w;
+    }
+    if (c == PosY) return oe_base::wrapDeg(v);
+    return v;
+}
+
+int activeChannels(double num_engines) {
+    long n = std::lround(num_engines);
+    if (n < 0) n = 0;
+    if (n > PropulsionArray::CAPACITY) n = PropulsionArray::CAPACITY;
+    return EngineBase + ENGINE_CHANNELS * static_cast<int>(n);
+}
+
+// 通道值 -> 预测值上的量化整数差 -> 重建值, 编解码两端共用
+double reconstruct(int c, double predicted, std::int64_t delta, double quantum) {
+    const std::int64_t base = std::llround(predicted / quantum);
+    return normalize(c, static_cast<double>(base + delta) * quantum);
+}
+
+bool getVarint(const std::uint8_t*& p, const std::uint8_t* end, std::uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p == end) return false;
+        const std::uint8_t b = *p++;
+        v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+bool getSigned(const std::uint8_t*& p, const std::uint8_t* end, std::int64_t& v) {
+    std::uint64_t u = 0;
+    if (!getVarint(p, end, u)) return false;
+    v = static_cast<std::int64_t>(u >> 1) ^ -static_cast<std::int64_t>(u & 1);
+    return true;
+}
+
+// 名称 -> 通道号, 与 JSBSimStateFields 的表同序
+int channelIndex(const std::string& name) {
+    std::size_t count = 0;
+    if (name.compare(0, 6, "engine") == 0) {
+        const char* p = name.c_str() + 6;
+        char* end = nullptr;
+        const long idx = std::strtol(p, &end, 10);
+        if (end == p || *end != '.' || idx < 0 || idx >= PropulsionArray::CAPACITY) return -1;
+        const state_fields::Entry* table = state_fields::engineTable(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (std::strcmp(end + 1, table[i].name) == 0) return EngineBase + static_cast<int>(idx) * ENGINE_CHANNELS + static_cast<int>(i);
+        }
+        return -1;
+    }
+    const state_fields::Entry* table = state_fields::scalarTable(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (name == table[i].name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+} // namespace
+
+Config Config::defaults() {
+    Config cfg;
+    auto set = [&cfg](int first, int last, double q, double th) {
+        for (int c = first; c <= last; ++c) {
+            cfg.quantum[c] = q;
+            cfg.threshold[c] = th;
+        }
+    };
+    set(PosX, PosY, 1e-7, 2e-6);        // 度: 约1厘米 / 0.2米
+    set(PosZ, PosZ, 0.01, 0.2);
+    set(VelN, VelD, 0.01, 0.1);
+    set(AccN, AccD, 0.01, 0.5);
+    set(Alt, Alt, 0.01, 0.2);
+    set(Roll, Yaw, 1e-4, 0.005);
+    set(RateP, RateR, 1e-4, 0.01);
+    set(GLoad, GLoad, 0.001, 0.05);
+    set(Mach, Mach, 1e-4, 0.005);
+    set(Alpha, Gamma, 1e-4, 0.005);
+    set(Cas, Cas, 0.01, 0.5);
+    set(TotalWeight, FuelWeight, 0.1, 5.0);
+    set(OnGround, NumEngines, 1.0, 0.5);
+    for (int e = 0; e < PropulsionArray::CAPACITY; ++e) {
+        const int b = EngineBase + e * ENGINE_CHANNELS;
+        set(b + 0, b + 0, 1.0, 50.0);   // thrust_lbf
+        set(b + 1, b + 1, 1.0, 20.0);   // rpm
+        set(b + 2, b + 2, 0.1, 5.0);    // fuel_flow_pph
+        set(b + 3, b + 3, 0.1, 0.5);    // pla_pct
+    }
+    return cfg;
+}
+
+bool Config::setPrecision(const std::string& name, double quantum_value, double threshold_value) {
+    const int c = channelIndex(name);
+    if (c < 0 || quantum_value <= 0.0) return false;
+    if (c >= EngineBase) {
+        // 所有发动机的同名字段一起设置
+        const int field = (c - EngineBase) % ENGINE_CHANNELS;
+        for (int e = 0; e < PropulsionArray::CAPACITY; ++e) {
+            quantum[EngineBase + e * ENGINE_CHANNELS + field] = quantum_value;
+            threshold[EngineBase + e * ENGINE_CHANNELS + field] = threshold_value;
+        }
+        return true;
+    }
+    quantum[c] = quantum_value;
+    threshold[c] = threshold_value;
+    return true;
+}
+
+void toChannels(const JSBSimAircraftState& s, Channels& c) {
+    std::size_t count = 0;
+    const state_fields::Entry* scalars = state_fields::scalarTable(count);
+    for (std::size_t i = 0; i < count; ++i) c[i] = scalars[i].getter(s, -1);
+    const state_fields::Entry* engine = state_fields::engineTable(count);
+    for (int e = 0; e < PropulsionArray::CAPACITY; ++e) {
+        for (std::size_t f = 0; f < count; ++f) c[EngineBase + e * ENGINE_CHANNELS + f] = engine[f].getter(s, e);
+    }
+}
+
+void fromChannels(const Channels& c, JSBSimAircraftState& s) {
+    s.position_ned.set(c[PosX], c[PosY], c[PosZ]);
+    s.velocity_ned.set(c[VelN], c[VelE], c[VelD]);
+    s.accel_ned.set(c[AccN], c[AccE], c[AccD]);
+    s.altitude_sl_m = c[Alt];
+    s.roll_rad = c[Roll];
+    s.pitch_rad = c[Pitch];
+    s.yaw_rad = c[Yaw];
+    s.ang_vel_rps.set(c[RateP], c[RateQ], c[RateR]);
+    s.g_load = c[GLoad];
+    s.mach = c[Mach];
+    s.alpha_rad = c[Alpha];
+    s.beta_rad = c[Beta];
+    s.flight_path_rad = c[Gamma];
+    s.calibrated_airspeed_kts = c[Cas];
+    s.total_weight_lbs = c[TotalWeight];
+    s.fuel_weight_lbs = c[FuelWeight];
+    s.on_ground = c[OnGround] >= 0.5;
+    s.num_engines = (activeChannels(c[NumEngines]) - EngineBase) / ENGINE_CHANNELS;
+    s.propulsion.resize(s.num_engines);
+    for (int e = 0; e < s.num_engines; ++e) {
+        const double* p = &c[EngineBase + e * ENGINE_CHANNELS];
+        s.propulsion[e].thrust_lbf = p[0];
+        s.propulsion[e].rpm = p[1];
+        s.propulsion[e].fuel_flow_pph = p[2];
+        s.propulsion[e].pla_pct = p[3];
+    }
+}
+
+// --- DeadReckoner ---
+
+void DeadReckoner::predict(double t, Channels& out) const {
+    const double dt = t - m_t0;
+    for (int c = 0; c < CHANNEL_COUNT; ++c) out[c] = m_value0[c] + m_rate[c] * dt;
+    out[Roll] = normalize(Roll, out[Roll]);
+    out[Yaw] = normalize(Yaw, out[Yaw]);
+    out[PosY] = normalize(PosY, out[PosY]);
+}
+
+void DeadReckoner::anchor(double t, const Channels& values) {
+    m_value0 = values;
+    m_rate.fill(0.0);
+    m_t0 = t;
+    m_valid = true;
+
+    // 位置: 纬度/经度(度)按北/东速度, 高度按下向速度; position_ned.z 的正负约定由它与高度的关系判断
+    const double lat_rad = values[PosX] * oe_base::angle::D2RCC;
+    const double cos_lat = std::max(std::cos(lat_rad), 1e-6);
+    m_rate[PosX] = values[VelN] / oe_base::wgs84::A * oe_base::angle::R2DCC;
+    m_rate[PosY] = values[VelE] / (oe_base::wgs84::A * cos_lat) * oe_base::angle::R2DCC;
+    const double z_up = std::fabs(values[PosZ] - values[Alt]) <= std::fabs(values[PosZ] + values[Alt]) ? 1.0 : -1.0;
+    m_rate[PosZ] = -values[VelD] * z_up;
+    m_rate[Alt] = -values[VelD];
+    m_rate[VelN] = values[AccN];
+    m_rate[VelE] = values[AccE];
+    m_rate[VelD] = values[AccD];
+
+    // 欧拉角速率
+    const double sphi = std::sin(values[Roll]), cphi = std::cos(values[Roll]);
+    double ctht = std::cos(values[Pitch]);
+    if (std::fabs(ctht) < 1e-3) ctht = ctht < 0.0 ? -1e-3 : 1e-3;
+    const double ttht = std::sin(values[Pitch]) / ctht;
+    const double p = values[RateP], q = values[RateQ], r = values[RateR];
+    m_rate[Roll] = p + (q * sphi + r * cphi) * ttht;
+    m_rate[Pitch] = q * cphi - r * sphi;
+    m_rate[Yaw] = (q * sphi + r * cphi) / ctht;
+}
+
+} // namespace state_stream
+
+using namespace state_stream;
+
+// --- StateStreamEncoder ---
+
+StateStreamEncoder::StateStreamEncoder(const Config& config) : m_config(config) {
+    // 随机纪元, 使重启后的发送端(序号从0重新开始)能被接收端识别
+    std::random_device rd;
+    const auto now = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    m_epoch = static_cast<std::uint32_t>(rd() ^ now ^ (now >> 32));
+}
+
+void StateStreamEncoder::putVarint(std::uint64_t v) {
+    while (v >= 0x80) {
+        m_packet.push_back(static_cast<std::uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    m_packet.push_back(static_cast<std::uint8_t>(v));
+}
+
+void StateStreamEncoder::putSigned(std::int64_t v) {
+    putVarint((static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63));
+}
+
+void StateStreamEncoder::beginPacket(double sim_time) {
+    // 强制关键帧覆盖其所在帧拆分出的所有数据包, 到以新的时刻开始下一帧时才清除
+    if (m_keyframeAll) {
+        if (!m_keyframeFrameKnown) {
+            m_keyframeTime = sim_time;
+            m_keyframeFrameKnown = true;
+        } else if (sim_time != m_keyframeTime) {
+            m_keyframeAll = false;
+        }
+    }
+    m_time = sim_time;
+    m_packetOpen = true;
+    m_packet.clear();
+    m_packet.push_back(PACKET_MAGIC);
+    m_packet.push_back(PACKET_VERSION);
+    for (int i = 0; i < 4; ++i) m_packet.push_back(static_cast<std::uint8_t>(m_epoch >> (8 * i)));
+    putVarint(m_sequence);
+    std::uint8_t bytes[sizeof(double)];
+    std::memcpy(bytes, &sim_time, sizeof(double));
+    m_packet.insert(m_packet.end(), bytes, bytes + sizeof(double));
+}
+
+void StateStreamEncoder::requestKeyframes() {
+    m_keyframeAll = true;
+    m_keyframeFrameKnown = m_packetOpen;
+    m_keyframeTime = m_time;
+}
+
+bool StateStreamEncoder::addEntity(std::uint32_t id, const JSBSimAircraftState& state) {
+    Channels actual;
+    toChannels(state, actual);
+    Entity& e = m_entities[id];
+    const bool keyframe = !e.mirror.valid() || m_keyframeAll || m_time < e.mirror.anchorTime() ||
+                          m_time - e.last_keyframe >= m_config.keyframe_interval_s;
+
+    Channels predicted{};
+    if (!keyframe) e.mirror.predict(m_time, predicted);
+
+    // 先决定要发送的字段并算出重建值, 再写入记录
+    Channels rebuilt = predicted;
+    std::uint64_t mask = 0;
+    std::int64_t deltas[CHANNEL_COUNT];
+    int sent = 0;
+    const int active = activeChannels(actual[NumEngines]);
+    for (int c = 0; c < active; ++c) {
+        const double q = m_config.quantum[c];
+        const double diff = wrapDiff(c, actual[c] - predicted[c]);
+        if (!keyframe && std::fabs(diff) <= std::max(m_config.threshold[c], 0.5 * q)) continue;
+        const std::int64_t delta = std::llround(diff / q);
+        rebuilt[c] = reconstruct(c, predicted[c], delta, q);
+        mask |= std::uint64_t(1) << c;
+        deltas[sent++] = delta;
+    }
+    if (mask == 0 && m_time - e.last_sent < m_config.heartbeat_s) return false;
+
+    putVarint(id);
+    m_packet.push_back(keyframe ? FLAG_KEYFRAME : 0);
+    putVarint(mask);
+    for (int i = 0; i < sent; ++i) putSigned(deltas[i]);
+
+    if (mask) e.mirror.anchor(m_time, rebuilt);
+    e.last_sent = m_time;
+    if (keyframe) {
+        e.last_keyframe = m_time;
+        ++m_stats.keyframes;
+    }
+    ++m_stats.records;
+    m_stats.fields += static_cast<std::uint64_t>(sent);
+    return true;
+}
+
+void StateStreamEncoder::removeEntity(std::uint32_t id) {
+    if (m_entities.erase(id) == 0) return;
+    putVarint(id);
+    m_packet.push_back(FLAG_REMOVE);
+    ++m_stats.records;
+}
+
+bool StateStreamEncoder::full() const {
+    return m_packet.size() >= m_config.max_packet_bytes;
+}
+
+const std::vector<std::uint8_t>& StateStreamEncoder::finishPacket() {
+    ++m_sequence;
+    ++m_stats.packets;
+    m_stats.bytes += m_packet.size();
+    m_packetOpen = false;
+    return m_packet;
+}
+
+// --- StateStreamDecoder ---
+
+StateStreamDecoder::StateStreamDecoder(const Config& config) : m_config(config) {}
+
+bool StateStreamDecoder::decode(const std::uint8_t* data, std::size_t size) {
+    const std::uint8_t* p = data;
+    const std::uint8_t* end = data + size;
+    std::uint64_t sequence = 0;
+    if (size < 6 || p[0] != PACKET_MAGIC || p[1] != PACKET_VERSION) return false;
+    const std::uint32_t epoch = static_cast<std::uint32_t>(p[2]) | static_cast<std::uint32_t>(p[3]) << 8 |
+                                static_cast<std::uint32_t>(p[4]) << 16 | static_cast<std::uint32_t>(p[5]) << 24;
+    p += 6;
+    if (!getVarint(p, end, sequence) || end - p < static_cast<std::ptrdiff_t>(sizeof(double))) return false;
+    double t = 0.0;
+    std::memcpy(&t, p, sizeof(double));
+    p += sizeof(double);
+
+    // 以第一个包同步序号; 纪元改变表示发送端重启, 其镜像已清空, 接收端丢弃旧实体后重新同步
+    if (!m_synced || epoch != m_epoch) {
+        if (m_synced && epoch == m_previousEpoch) return true;
+        if (m_synced) {
+            m_previousEpoch = m_epoch;
+            m_entities.clear();
+            ++m_restarts;
+        }
+        m_synced = true;
+        m_epoch = epoch;
+        m_nextSequence = sequence;
+    }
+
+    // 乱序到达的旧包丢弃, 跳号计为丢包
+    if (sequence < m_nextSequence) return true;
+    m_lost += sequence - m_nextSequence;
+    m_nextSequence = sequence + 1;
+
+    while (p < end) {
+        std::uint64_t id = 0, mask = 0;
+        if (!getVarint(p, end, id) || p == end) return false;
+        const std::uint8_t flags = *p++;
+        if (flags & FLAG_REMOVE) {
+            m_entities.erase(static_cast<std::uint32_t>(id));
+            continue;
+        }
+        if (!getVarint(p, end, mask)) return false;
+
+        Entity& e = m_entities[static_cast<std::uint32_t>(id)];
+        const bool keyframe = (flags & FLAG_KEYFRAME) != 0;
+        // 错过关键帧的实体在下一个关键帧之前无法重建, 仍需读完记录
+        const bool usable = keyframe || e.dr.valid();
+        Channels values{};
+        if (!keyframe && usable) e.dr.predict(t, values);
+        for (int c = 0; c < CHANNEL_COUNT; ++c) {
+            if (!(mask & (std::uint64_t(1) << c))) continue;
+            std::int64_t delta = 0;
+            if (!getSigned(p, end, delta)) return false;
+            values[c] = reconstruct(c, keyframe ? 0.0 : values[c], delta, m_config.quantum[c]);
+        }
+        e.last_heard = t;
+        if (usable && mask) e.dr.anchor(t, values);
+    }
+    return true;
+}
+
+bool StateStreamDecoder::stateAt(std::uint32_t id, double t, JSBSimAircraftState& out) const {
+    const auto it = m_entities.find(id);
+    if (it == m_entities.end() || !it->second.dr.valid()) return false;
+    Channels values;
+    it->second.dr.predict(t, values);
+    fromChannels(values, out);
+    return true;
+}
+
+std::vector<std::uint32_t> StateStreamDecoder::entityIds() const {
+    std::vector<std::uint32_t> ids;
+    ids.reserve(m_entities.size());
+    for (const auto& kv : m_entities) ids.push_back(kv.first);
+    return ids;
+}
+
+double StateStreamDecoder::lastHeard(std::uint32_t id) const {
+    const auto it = m_entities.find(id);
+    return it == m_entities.end() ? -1.0 : it->second.last_heard;
+}
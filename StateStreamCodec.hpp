@@ -0,0 +1,167 @@
+// StateStreamCodec.hpp
+#ifndef STATE_STREAM_CODEC_HPP
+#define STATE_STREAM_CODEC_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "JSBSimAircraftState.hpp"
+
+// --- 分布式实体的状态流编解码 ---
+// 发送端每帧对每架飞机:
+//   1. 按与接收端相同的航位推算(dead reckoning)预测该机当前状态;
+//   2. 只发送实际值与预测值之差超过门限的字段, 数值按各字段的量化步长取整, 以"相对预测值的整数差"变长编码;
+//   3. 发送端保存一份与接收端逐位一致的镜像, 因此接收端在两次更新之间外推的误差始终受门限约束。
+// 定期发送关键帧(全部字段), 丢包后由下一个关键帧恢复; 长时间无字段需要发送时发心跳记录。
+// 每个编码器实例有随机的发送端纪元, 序号从0开始; 接收端以收到的第一个包同步序号,
+// 纪元改变(发送端重启)时丢弃已有实体并重新同步。
+//
+// 数据包: [0x5A][版本][发送端纪元 uint32][序号 varint][仿真时间 double][记录...]
+// 记录:   [实体ID varint][标志 1字节][字段掩码 varint][每个置位字段: 量化差 zigzag varint]
+//
+// 字段(通道)顺序与 JSBSimStateFields.hpp 一致: 26 个标量字段, 之后每台发动机4个字段。
+// 解码后 roll 在 [-PI, PI), yaw 在 [0, 2PI), position_ned.y(经度)在 [-180, 180)。
+namespace state_stream {
+
+enum Channel : int {
+    PosX, PosY, PosZ, VelN, VelE, VelD, AccN, AccE, AccD, Alt,
+    Roll, Pitch, Yaw, RateP, RateQ, RateR,
+    GLoad, Mach, Alpha, Beta, Gamma, Cas, TotalWeight, FuelWeight, OnGround, NumEngines,
+    EngineBase
+};
+constexpr int ENGINE_CHANNELS = 4; // thrust_lbf, rpm, fuel_flow_pph, pla_pct
+constexpr int CHANNEL_COUNT = EngineBase + ENGINE_CHANNELS * PropulsionArray::CAPACITY;
+static_assert(CHANNEL_COUNT <= 64, "channel mask must fit in 64 bits");
+
+using Channels = std::array<double, CHANNEL_COUNT>;
+
+struct Config {
+    Channels quantum{};             // 量化步长
+    Channels threshold{};           // 预测误差超过该值才发送
+    double keyframe_interval_s = 2.0;
+    double heartbeat_s = 1.0;
+    std::size_t max_packet_bytes = 1000; // 软上限: full() 之后的一条记录仍可能超出
+
+    // 默认精度: 位置约1厘米量化、0.2米门限, 姿态1e-4弧度量化、0.005弧度门限等
+    static Config defaults();
+    // name 与 JSBSimStateFields 相同, 如 "altitude_sl_m"、"engine0.thrust_lbf"; 未知名称返回 false
+    bool setPrecision(const std::string& name, double quantum_value, double threshold_value);
+};
+
+// 状态 <-> 通道数组
+void toChannels(const JSBSimAircraftState& s, Channels& c);
+void fromChannels(const Channels& c, JSBSimAircraftState& s);
+
+// --- 航位推算模型 ---
+// 发送端镜像与接收端共用, 保证两边的预测逐位一致。
+// 位置按锚定时刻的速度、速度按加速度、姿态按机体角速度换算的欧拉角速率线性外推, 其余字段保持。
+class DeadReckoner {
+public:
+    bool valid() const { return m_valid; }
+    double anchorTime() const { return m_t0; }
+
+    void predict(double t, Channels& out) const;
+    // 以时刻 t 的完整重建值(收到的字段取新值, 其余取预测值)重新锚定
+    void anchor(double t, const Channels& values);
+
+private:
+    Channels m_value0{};
+    Channels m_rate{};
+    double m_t0 = 0.0;
+    bool m_valid = false;
+};
+
+struct EncoderStats {
+    std::uint64_t packets = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t records = 0;
+    std::uint64_t keyframes = 0;
+    std::uint64_t fields = 0;
+};
+
+} // namespace state_stream
+
+// --- 编码器 ---
+// 用法: beginPacket(t); 对每架飞机 addEntity(id, state); finishPacket() 取得数据包。
+// 同一帧的飞机较多时, full() 为 true 后先 finishPacket() 发送, 再以同一时刻 beginPacket()。
+class StateStreamEncoder {
+public:
+    explicit StateStreamEncoder(const state_stream::Config& config = state_stream::Config::defaults());
+
+    void beginPacket(double sim_time);
+    // 返回是否写入了记录(无需发送的实体不占字节)
+    bool addEntity(std::uint32_t id, const JSBSimAircraftState& state);
+    // 通知接收端删除实体
+    void removeEntity(std::uint32_t id);
+    bool full() const;
+    const std::vector<std::uint8_t>& finishPacket();
+
+    // 强制关键帧(例如新的接收端加入): 作用于当前帧(已在写包时)或下一帧的全部数据包, 直到以新的时刻 beginPacket()
+    void requestKeyframes();
+
+    std::uint32_t epoch() const { return m_epoch; }
+
+    const state_stream::EncoderStats& stats() const { return m_stats; }
+    const state_stream::Config& config() const { return m_config; }
+
+private:
+    struct Entity {
+        state_stream::DeadReckoner mirror;
+        double last_keyframe = -1e300;
+        double last_sent = -1e300;
+    };
+
+    void putVarint(std::uint64_t v);
+    void putSigned(std::int64_t v);
+
+    state_stream::Config m_config;
+    std::unordered_map<std::uint32_t, Entity> m_entities;
+    std::vector<std::uint8_t> m_packet;
+    std::uint32_t m_epoch = 0;
+    std::uint64_t m_sequence = 0;
+    double m_time = 0.0;
+    bool m_packetOpen = false;
+    bool m_keyframeAll = false;
+    bool m_keyframeFrameKnown = false; // m_keyframeTime 已确定为强制关键帧所在帧的时刻
+    double m_keyframeTime = 0.0;
+    state_stream::EncoderStats m_stats;
+};
+
+// --- 解码器 ---
+class StateStreamDecoder {
+public:
+    explicit StateStreamDecoder(const state_stream::Config& config = state_stream::Config::defaults());
+
+    // 格式错误的数据包返回 false(已解析的记录仍然生效)
+    bool decode(const std::uint8_t* data, std::size_t size);
+
+    // 时刻 t 的外推状态; 未收到过关键帧的实体返回 false
+    bool stateAt(std::uint32_t id, double t, JSBSimAircraftState& out) const;
+    std::vector<std::uint32_t> entityIds() const;
+    // 最近一次收到该实体记录(含心跳)的仿真时间, 用于判断超时
+    double lastHeard(std::uint32_t id) const;
+
+    std::uint64_t packetsLost() const { return m_lost; }
+    // 检测到发送端重启(纪元改变)的次数
+    std::uint64_t senderRestarts() const { return m_restarts; }
+
+private:
+    struct Entity {
+        state_stream::DeadReckoner dr;
+        double last_heard = 0.0;
+    };
+
+    state_stream::Config m_config;
+    std::unordered_map<std::uint32_t, Entity> m_entities;
+    bool m_synced = false;
+    std::uint32_t m_epoch = 0;
+    std::uint32_t m_previousEpoch = 0; // 重启前的纪元, 迟到的旧包直接丢弃
+    std::uint64_t m_nextSequence = 0;
+    std::uint64_t m_lost = 0;
+    std::uint64_t m_restarts = 0;
+};
+
+#endif // STATE_STREAM_CODEC_HPP
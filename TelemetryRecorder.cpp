@@ -0,0 +1,210 @@
+// TelemetryRecorder.cpp
+#include "TelemetryRecorder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+TelemetryRecorder::TelemetryRecorder() = default;
+
+TelemetryRecorder::~TelemetryRecorder() {
+    close();
+}
+
+bool TelemetryRecorder::open(const std::string& path, const std::vector<std::string>& columns,
+                             std::size_t ring_rows, std::size_t chunk_rows) {
+    close();
+    if (columns.empty() || chunk_rows == 0) return false;
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file) {
+        std::cerr << "Failed to open telemetry file: " << path << std::endl;
+        return false;
+    }
+
+    m_columns = columns;
+    const std::size_t ncols = m_columns.size();
+
+    // --- 文件头与列名表 ---
+    const std::uint64_t names_bytes = ncols * telemetry_file::NAME_BYTES;
+    const std::uint64_t header_bytes = (sizeof(telemetry_file::FileHeader) + names_bytes + 63) / 64 * 64;
+
+    telemetry_file::FileHeader header{};
+    std::memcpy(header.magic, telemetry_file::MAGIC, sizeof(header.magic));
+    header.version = telemetry_file::VERSION;
+    header.num_columns = static_cast<std::uint32_t>(ncols);
+    header.chunk_rows = chunk_rows;
+    header.header_bytes = header_bytes;
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<char> names(header_bytes - sizeof(header), '\0');
+    for (std::size_t c = 0; c < ncols; ++c) {
+        const std::size_t len = std::min(m_columns[c].size(), telemetry_file::NAME_BYTES - 1);
+        std::memcpy(names.data() + c * telemetry_file::NAME_BYTES, m_columns[c].data(), len);
+    }
+    m_file.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    // --- 缓冲区 ---
+    m_ringRows = 1;
+    while (m_ringRows < std::max<std::size_t>(ring_rows, 2)) m_ringRows <<= 1;
+    m_ringMask = m_ringRows - 1;
+    m_ring.assign(m_ringRows * ncols, 0.0);
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+
+    m_chunkRows = chunk_rows;
+    m_chunkFill = 0;
+    m_chunk.assign(ncols * m_chunkRows, 0.0);
+
+    m_running.store(true, std::memory_order_release);
+    m_writer = std::thread([this] { writerLoop(); });
+    return true;
+}
+
+bool TelemetryRecorder::openForState(const std::string& path, const std::vector<std::string>& fields,
+                                     std::size_t ring_rows, std::size_t chunk_rows) {
+    std::vector<std::string> columns{"sim_time", "entity_id"};
+    std::vector<StateFieldRef> refs;
+    for (const auto& name : fields) {
+        StateFieldRef ref = findStateField(name);
+        if (!ref.valid()) {
+            std::cerr << "Unknown state field: " << name << std::endl;
+            return false;
+        }
+        refs.push_back(ref);
+        columns.push_back(name);
+    }
+    if (!open(path, columns, ring_rows, chunk_rows)) return false;
+    m_fields = std::move(refs);
+    return true;
+}
+
+void TelemetryRecorder::close() {
+    if (!m_running.exchange(false, std::memory_order_acq_rel)) return;
+    m_writer.join();
+    flushChunk();
+    m_file.close();
+    m_fields.clear();
+}
+
+// --- 模拟线程接口 ---
+double* TelemetryRecorder::acquireSlot() {
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= m_ringRows) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return m_ring.data() + (head & m_ringMask) * m_columns.size();
+}
+
+void TelemetryRecorder::commitSlot() {
+    m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool TelemetryRecorder::push(const double* row) {
+    if (!isOpen()) return false;
+    double* slot = acquireSlot();
+    if (!slot) return false;
+    std::memcpy(slot, row, m_columns.size() * sizeof(double));
+    commitSlot();
+    return true;
+}
+
+bool TelemetryRecorder::push(double sim_time, int entity_id, const JSBSimAircraftState& state) {
+    if (!isOpen() || m_fields.size() + 2 != m_columns.size()) return false;
+    double* slot = acquireSlot();
+    if (!slot) return false;
+    slot[0] = sim_time;
+    slot[1] = static_cast<double>(entity_id);
+    for (std::size_t i = 0; i < m_fields.size(); ++i) slot[i + 2] = m_fields[i](state);
+    commitSlot();
+    return true;
+}
+
+// --- 后台写线程 ---
+void TelemetryRecorder::writerLoop() {
+    const std::size_t ncols = m_columns.size();
+    for (;;) {
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail == head) {
+            if (!m_running.load(std::memory_order_acquire)) {
+                // 停止标志之后生产者不再提交, 再确认一次即可退出
+                if (m_head.load(std::memory_order_acquire) == tail) return;
+                continue;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        // 行 -> 列转置
+        for (; tail != head; ++tail) {
+            const double* row = m_ring.data() + (tail & m_ringMask) * ncols;
+            for (std::size_t c = 0; c < ncols; ++c) m_chunk[c * m_chunkRows + m_chunkFill] = row[c];
+            if (++m_chunkFill == m_chunkRows) flushChunk();
+        }
+        m_tail.store(tail, std::memory_order_release);
+    }
+}
+
+void TelemetryRecorder::flushChunk() {
+    if (m_chunkFill == 0) return;
+    telemetry_file::ChunkHeader chunk{};
+    chunk.row_count = m_chunkFill;
+    m_file.write(reinterpret_cast<const char*>(&chunk), sizeof(chunk));
+    // 未填满的尾部清零后整块写出, 保持块大小固定
+    if (m_chunkFill < m_chunkRows) {
+        for (std::size_t c = 0; c < m_columns.size(); ++c) {
+            std::fill(m_chunk.begin() + c * m_chunkRows + m_chunkFill, m_chunk.begin() + (c + 1) * m_chunkRows, 0.0);
+        }
+    }
+    m_file.write(reinterpret_cast<const char*>(m_chunk.data()), static_cast<std::streamsize>(m_chunk.size() * sizeof(double)));
+    m_chunkFill = 0;
+}
+
+// --- .jtlm 文件读取 ---
+bool TelemetryFileReader::open(const std::string& path) {
+    m_file.open(path, std::ios::binary);
+    if (!m_file) return false;
+
+    telemetry_file::FileHeader header{};
+    m_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!m_file || std::memcmp(header.magic, telemetry_file::MAGIC, sizeof(header.magic)) != 0
+        || header.version != telemetry_file::VERSION || header.chunk_rows == 0) {
+        std::cerr << "Not a telemetry file: " << path << std::endl;
+        return false;
+    }
+
+    std::vector<char> names(header.num_columns * telemetry_file::NAME_BYTES);
+    m_file.read(names.data(), static_cast<std::streamsize>(names.size()));
+    m_columns.clear();
+    for (std::uint32_t c = 0; c < header.num_columns; ++c) {
+        const char* name = names.data() + c * telemetry_file::NAME_BYTES;
+        m_columns.emplace_back(name, strnlen(name, telemetry_file::NAME_BYTES));
+    }
+
+    m_chunkRows = header.chunk_rows;
+    m_headerBytes = header.header_bytes;
+    m_chunk.assign(m_columns.size() * m_chunkRows, 0.0);
+
+    m_file.seekg(0, std::ios::end);
+    const std::uint64_t file_bytes = static_cast<std::uint64_t>(m_file.tellg());
+    const std::uint64_t chunk_bytes = telemetry_file::chunkBytes(m_columns.size(), m_chunkRows);
+    m_numChunks = file_bytes > m_headerBytes ? static_cast<std::size_t>((file_bytes - m_headerBytes) / chunk_bytes) : 0;
+    return true;
+}
+
+std::size_t TelemetryFileReader::readChunk(std::size_t k) {
+    if (k >= m_numChunks) return 0;
+    m_file.clear();
+    m_file.seekg(static_cast<std::streamoff>(m_headerBytes + k * telemetry_file::chunkBytes(m_columns.size(), m_chunkRows)));
+
+    telemetry_file::ChunkHeader chunk{};
+    m_file.read(reinterpret_cast<char*>(&chunk), sizeof(chunk));
+    m_file.read(reinterpret_cast<char*>(m_chunk.data()), static_cast<std::streamsize>(m_chunk.size() * sizeof(double)));
+    if (!m_file) return 0;
+    return static_cast<std::size_t>(std::min<std::uint64_t>(chunk.row_count, m_chunkRows));
+}
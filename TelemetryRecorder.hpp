@@ -0,0 +1,125 @@
+// TelemetryRecorder.hpp
+#ifndef TELEMETRY_RECORDER_HPP
+#define TELEMETRY_RECORDER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "JSBSimAircraftState.hpp"
+#include "JSBSimStateFields.hpp"
+
+// --- 二进制列式遥测文件格式 (.jtlm) ---
+// [文件头 64字节][列名表 num_columns * 32字节, 补齐到64字节]
+// [数据块0][数据块1]...
+// 每个数据块: [块头 64字节][列0: chunk_rows个double][列1]...[列N-1]
+// 数据块大小固定, 第k块偏移 = header_bytes + k * chunkBytes(), 可直接内存映射按列访问;
+// 最后一块的有效行数由块头 row_count 给出。所有数值为本机字节序。
+namespace telemetry_file {
+
+constexpr char MAGIC[8] = {'J', 'S', 'B', 'T', 'L', 'M', '0', '1'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::size_t NAME_BYTES = 32;
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t num_columns;
+    std::uint64_t chunk_rows;
+    std::uint64_t header_bytes;   // 文件头 + 列名表(已对齐), 即第一个数据块的偏移
+    std::uint64_t reserved[4];
+};
+static_assert(sizeof(FileHeader) == 64, "FileHeader must be 64 bytes");
+
+struct ChunkHeader {
+    std::uint64_t row_count;
+    std::uint64_t reserved[7];
+};
+static_assert(sizeof(ChunkHeader) == 64, "ChunkHeader must be 64 bytes");
+
+inline std::uint64_t chunkBytes(std::uint64_t num_columns, std::uint64_t chunk_rows) {
+    return sizeof(ChunkHeader) + num_columns * chunk_rows * sizeof(double);
+}
+
+} // namespace telemetry_file
+
+// --- 异步遥测记录器 ---
+// 模拟线程通过无锁单生产者/单消费者环形缓冲提交行数据(每行一次memcpy),
+// 后台线程将行转置为列并按固定大小数据块写入 .jtlm 文件。
+// push() 只能由同一个线程调用; 缓冲满时丢弃该行并计数, 不阻塞模拟线程。
+class TelemetryRecorder {
+public:
+    TelemetryRecorder();
+    ~TelemetryRecorder();
+
+    TelemetryRecorder(const TelemetryRecorder&) = delete;
+    TelemetryRecorder& operator=(const TelemetryRecorder&) = delete;
+
+    // columns 为原始列名; ring_rows 向上取整为2的幂
+    bool open(const std::string& path, const std::vector<std::string>& columns,
+              std::size_t ring_rows = 1 << 14, std::size_t chunk_rows = 4096);
+    // 以 JSBSimAircraftState 字段名打开, 自动在最前面加上 sim_time 与 entity_id 两列
+    bool openForState(const std::string& path, const std::vector<std::string>& fields,
+                      std::size_t ring_rows = 1 << 14, std::size_t chunk_rows = 4096);
+    void close(); // 排空缓冲、写出最后一块并结束后台线程
+
+    bool isOpen() const { return m_running.load(std::memory_order_acquire); }
+    std::size_t numColumns() const { return m_columns.size(); }
+    std::uint64_t droppedRows() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // --- 模拟线程接口 ---
+    bool push(const double* row);
+    bool push(double sim_time, int entity_id, const JSBSimAircraftState& state);
+
+private:
+    double* acquireSlot();
+    void commitSlot();
+    void writerLoop();
+    void flushChunk();
+
+    std::vector<std::string> m_columns;
+    std::vector<StateFieldRef> m_fields; // openForState() 时解析的字段
+
+    // 环形缓冲: m_ringRows 行, 每行 numColumns() 个double
+    std::vector<double> m_ring;
+    std::size_t m_ringRows = 0;
+    std::size_t m_ringMask = 0;
+    alignas(64) std::atomic<std::size_t> m_head{0}; // 生产者写入位置
+    alignas(64) std::atomic<std::size_t> m_tail{0}; // 消费者读取位置
+    alignas(64) std::atomic<std::uint64_t> m_dropped{0};
+
+    // 后台写线程状态
+    std::ofstream m_file;
+    std::vector<double> m_chunk; // 列主序, numColumns() * m_chunkRows
+    std::size_t m_chunkRows = 0;
+    std::size_t m_chunkFill = 0;
+    std::thread m_writer;
+    std::atomic<bool> m_running{false};
+};
+
+// --- .jtlm 文件读取 ---
+// 供离线导出工具使用, 逐块读入内存并按列访问
+class TelemetryFileReader {
+public:
+    bool open(const std::string& path);
+
+    const std::vector<std::string>& columns() const { return m_columns; }
+    std::size_t numChunks() const { return m_numChunks; }
+
+    // 读入第 k 块, 返回有效行数; 之后通过 column(c)[row] 访问
+    std::size_t readChunk(std::size_t k);
+    const double* column(std::size_t c) const { return m_chunk.data() + c * m_chunkRows; }
+
+private:
+    std::ifstream m_file;
+    std::vector<std::string> m_columns;
+    std::vector<double> m_chunk;
+    std::uint64_t m_chunkRows = 0;
+    std::uint64_t m_headerBytes = 0;
+    std::size_t m_numChunks = 0;
+};
+
+#endif // TELEMETRY_RECORDER_HPP
@@ -0,0 +1,42 @@
+// TelemetrySchema.hpp
+#ifndef TELEMETRY_SCHEMA_HPP
+#define TELEMETRY_SCHEMA_HPP
+
+#include <string>
+#include <vector>
+
+// --- 遥测输出声明 ---
+// 调用方一次性声明每帧需要的输出: 按组选择 JSBSimAircraftState 中的字段,
+// 并可追加任意JSBSim属性路径(如 "fcs/elevator-pos-rad")。
+// 未选中的组在 updateStateFromJSBSim() 中直接跳过, 对应字段保持上一次的值。
+struct TelemetrySchema {
+    enum Group : unsigned {
+        Position     = 1u << 0, // position_ned, altitude_sl_m
+        Velocity     = 1u << 1, // velocity_ned
+        Acceleration = 1u << 2, // accel_ned
+        Attitude     = 1u << 3, // roll_rad, pitch_rad, yaw_rad
+        AngularRate  = 1u << 4, // ang_vel_rps
+        Aero         = 1u << 5, // g_load, mach, alpha, beta, flight_path, calibrated_airspeed
+        Systems      = 1u << 6, // total_weight_lbs, fuel_weight_lbs, on_ground
+        Propulsion   = 1u << 7, // propulsion[]
+        None         = 0u,
+        All          = 0xffu
+    };
+
+    unsigned groups = All;
+    std::vector<std::string> properties; // 额外的JSBSim属性路径, 结果按声明顺序输出
+
+    TelemetrySchema& select(unsigned g) { groups = g; return *this; }
+    TelemetrySchema& addProperty(const std::string& path) { properties.push_back(path); return *this; }
+
+    bool has(Group g) const { return (groups & g) != 0; }
+
+    // 批量无头运行的常用配置: 只要位置和姿态
+    static TelemetrySchema positionAttitude() {
+        TelemetrySchema schema;
+        schema.groups = Position | Attitude;
+        return schema;
+    }
+};
+
+#endif // TELEMETRY_SCHEMA_HPP
@@ -0,0 +1,231 @@
+// TrimCache.cpp
+#include "TrimCache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+
+namespace {
+const int MAX_NEIGHBOURS = 8;
+const double NEAR_CELLS = 1.0;   // 最近条目在此距离(格)以内时无需两侧都有邻居
+const std::size_t MAX_FILE_ENGINES = 64;
+const char* const FILE_MAGIC = "# JSBSim trim cache v3";
+const double RAD2DEG = 57.29577951308232;
+}
+
+TrimCache::TrimCache() : TrimCache(Quantization()) {}
+
+TrimCache::TrimCache(const Quantization& quantization, double max_neighbour_cells)
+    : m_quant(quantization), m_maxNeighbourCells(max_neighbour_cells) {}
+
+bool TrimCache::Key::operator<(const Key& o) const {
+    return std::tie(model, config, gamma, phi, alt, speed, weight) <
+           std::tie(o.model, o.config, o.gamma, o.phi, o.alt, o.speed, o.weight);
+}
+
+std::uint32_t TrimCache::makeConfig(bool gear_down, double flap_cmd_norm) {
+    const long flap = std::lround(std::max(0.0, std::min(1.0, flap_cmd_norm)) * 10.0);
+    return (gear_down ? 1u : 0u) | (static_cast<std::uint32_t>(flap) << 1);
+}
+
+TrimCache::Key TrimCache::makeKey(const std::string& model, const TrimConditions& c) const {
+    return Key{model, c.config,
+               std::llround(c.gamma_rad * RAD2DEG / m_quant.gamma_deg),
+               std::llround(c.phi_rad * RAD2DEG / m_quant.phi_deg),
+               std::llround(c.alt_m / m_quant.alt_m),
+               std::llround(c.speed_kts / m_quant.speed_kts),
+               std::llround(c.weight_lbs / m_quant.weight_lbs)};
+}
+
+bool TrimCache::lookup(const std::string& model, const TrimConditions& conditions, TrimSolution& solution) {
+    const Key key = makeKey(model, conditions);
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        solution = it->second;
+        ++m_exactHits;
+        return true;
+    }
+
+    // 同一模型、构型、航迹倾角与滚转角格的条目在 map 中连续, 取最近的若干个
+    const Key lo{model, conditions.config, key.gamma, key.phi, INT64_MIN, INT64_MIN, INT64_MIN};
+    const Key hi{model, conditions.config, key.gamma, key.phi, INT64_MAX, INT64_MAX, INT64_MAX};
+    const double query[3] = {conditions.alt_m / m_quant.alt_m, conditions.speed_kts / m_quant.speed_kts,
+                             conditions.weight_lbs / m_quant.weight_lbs};
+
+    const Key* nearest_key[MAX_NEIGHBOURS] = {};
+    const TrimSolution* nearest[MAX_NEIGHBOURS] = {};
+    double nearest_d2[MAX_NEIGHBOURS];
+    int found = 0;
+    for (auto e = m_entries.lower_bound(lo); e != m_entries.end() && !(hi < e->first); ++e) {
+        const double da = e->first.alt - query[0];
+        const double ds = e->first.speed - query[1];
+        const double dw = e->first.weight - query[2];
+        const double d2 = da * da + ds * ds + dw * dw;
+        if (d2 > m_maxNeighbourCells * m_maxNeighbourCells) continue;
+
+        // 插入排序维护最近的 MAX_NEIGHBOURS 个
+        int pos = found < MAX_NEIGHBOURS ? found++ : MAX_NEIGHBOURS;
+        while (pos > 0 && nearest_d2[pos - 1] > d2) {
+            if (pos < MAX_NEIGHBOURS) {
+                nearest_key[pos] = nearest_key[pos - 1];
+                nearest[pos] = nearest[pos - 1];
+                nearest_d2[pos] = nearest_d2[pos - 1];
+            }
+            --pos;
+        }
+        if (pos < MAX_NEIGHBOURS) {
+            nearest_key[pos] = &e->first;
+            nearest[pos] = &e->second;
+            nearest_d2[pos] = d2;
+        }
+    }
+
+    // 最近的条目在1格以内直接可用; 否则要求各方向上都有邻居位于查询点两侧(或与之同格), 只做内插
+    bool usable = found > 0 && nearest_d2[0] <= NEAR_CELLS * NEAR_CELLS;
+    if (!usable && found >= 2) {
+        usable = true;
+        for (int axis = 0; axis < 3 && usable; ++axis) {
+            bool below = false, above = false;
+            for (int i = 0; i < found; ++i) {
+                const Key& k = *nearest_key[i];
+                const double c = axis == 0 ? k.alt : axis == 1 ? k.speed : k.weight;
+                below = below || c <= query[axis] + 0.5;
+                above = above || c >= query[axis] - 0.5;
+            }
+            usable = below && above;
+        }
+    }
+    if (!usable) {
+        ++m_misses;
+        return false;
+    }
+
+    // 只合并与最近条目发动机数相同的解
+    const std::size_t engines = nearest[0]->throttle_cmd.size();
+    double total = 0.0;
+    TrimSolution sum;
+    sum.throttle_cmd.assign(engines, 0.0);
+    for (int i = 0; i < found; ++i) {
+        const TrimSolution& s = *nearest[i];
+        if (s.throttle_cmd.size() != engines) continue;
+        const double w = 1.0 / std::max(nearest_d2[i], 1e-12);
+        sum.alpha_rad += w * s.alpha_rad;
+        sum.beta_rad += w * s.beta_rad;
+        sum.phi_rad += w * s.phi_rad;
+        sum.elevator_cmd += w * s.elevator_cmd;
+        sum.aileron_cmd += w * s.aileron_cmd;
+        sum.rudder_cmd += w * s.rudder_cmd;
+        sum.pitch_trim_cmd += w * s.pitch_trim_cmd;
+        for (std::size_t k = 0; k < engines; ++k) sum.throttle_cmd[k] += w * s.throttle_cmd[k];
+        total += w;
+    }
+    solution.alpha_rad = sum.alpha_rad / total;
+    solution.beta_rad = sum.beta_rad / total;
+    solution.phi_rad = sum.phi_rad / total;
+    solution.elevator_cmd = sum.elevator_cmd / total;
+    solution.aileron_cmd = sum.aileron_cmd / total;
+    solution.rudder_cmd = sum.rudder_cmd / total;
+    solution.pitch_trim_cmd = sum.pitch_trim_cmd / total;
+    solution.throttle_cmd.resize(engines);
+    for (std::size_t k = 0; k < engines; ++k) solution.throttle_cmd[k] = sum.throttle_cmd[k] / total;
+    ++m_interpolated;
+    return true;
+}
+
+void TrimCache::store(const std::string& model, const TrimConditions& conditions, const TrimSolution& solution) {
+    const Key key = makeKey(model, conditions);
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_entries[key] = solution;
+}
+
+bool TrimCache::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) return false;
+
+    // 旧版本(单一油门、键不含航迹倾角与滚转角)的文件不兼容, 按失败处理
+    std::string line;
+    if (!std::getline(in, line) || line.compare(0, std::strlen(FILE_MAGIC), FILE_MAGIC) != 0) return false;
+
+    // 格号只在相同的量化下有意义
+    if (!std::getline(in, line)) return false;
+    {
+        std::istringstream fields(line);
+        std::string tag;
+        Quantization q;
+        fields >> tag >> q.alt_m >> q.speed_kts >> q.weight_lbs >> q.gamma_deg >> q.phi_deg;
+        if (!fields || tag != "quantization") return false;
+        if (q.alt_m != m_quant.alt_m || q.speed_kts != m_quant.speed_kts || q.weight_lbs != m_quant.weight_lbs ||
+            q.gamma_deg != m_quant.gamma_deg || q.phi_deg != m_quant.phi_deg) {
+            return false;
+        }
+    }
+
+    std::map<Key, TrimSolution> loaded;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        Key key;
+        TrimSolution s;
+        std::size_t engines = 0;
+        fields >> key.model >> key.config >> key.gamma >> key.phi >> key.alt >> key.speed >> key.weight
+               >> s.alpha_rad >> s.beta_rad >> s.phi_rad >> s.elevator_cmd >> s.aileron_cmd
+               >> s.rudder_cmd >> s.pitch_trim_cmd >> engines;
+        if (!fields || engines > MAX_FILE_ENGINES) return false;
+        s.throttle_cmd.resize(engines);
+        for (double& throttle : s.throttle_cmd) fields >> throttle;
+        std::string extra;
+        if (!fields || (fields >> extra)) return false;
+        loaded[key] = std::move(s);
+    }
+    if (in.bad()) return false;
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    for (auto& e : loaded) m_entries[e.first] = std::move(e.second);
+    return true;
+}
+
+bool TrimCache::save(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    out << FILE_MAGIC << "\n";
+    out << std::setprecision(17);
+    out << "quantization " << m_quant.alt_m << ' ' << m_quant.speed_kts << ' ' << m_quant.weight_lbs << ' '
+        << m_quant.gamma_deg << ' ' << m_quant.phi_deg << '\n';
+    for (const auto& e : m_entries) {
+        const Key& k = e.first;
+        const TrimSolution& s = e.second;
+        out << k.model << ' ' << k.config << ' ' << k.gamma << ' ' << k.phi << ' ' << k.alt << ' ' << k.speed << ' ' << k.weight << ' '
+            << s.alpha_rad << ' ' << s.beta_rad << ' ' << s.phi_rad << ' ' << s.elevator_cmd << ' '
+            << s.aileron_cmd << ' ' << s.rudder_cmd << ' ' << s.pitch_trim_cmd << ' ' << s.throttle_cmd.size();
+        for (double throttle : s.throttle_cmd) out << ' ' << throttle;
+        out << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+std::size_t TrimCache::size() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+TrimCache::Stats TrimCache::stats() const {
+    Stats s;
+    s.exact_hits = m_exactHits.load();
+    s.interpolated = m_interpolated.load();
+    s.misses = m_misses.load();
+    return s;
+}
+
+void TrimCache::clear() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_entries.clear();
+}
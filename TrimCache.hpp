@@ -0,0 +1,104 @@
+// TrimCache.hpp
+#ifndef TRIM_CACHE_HPP
+#define TRIM_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+// --- 配平条件与配平解 ---
+struct TrimConditions {
+    double alt_m = 0.0;
+    double speed_kts = 0.0;       // 真空速
+    double weight_lbs = 0.0;
+    double gamma_rad = 0.0;       // 初始条件的航迹倾角
+    double phi_rad = 0.0;         // 初始条件的滚转角
+    std::uint32_t config = 0;     // 构型, 见 TrimCache::makeConfig()
+};
+
+struct TrimSolution {
+    double alpha_rad = 0.0;
+    double beta_rad = 0.0;
+    double phi_rad = 0.0;
+    double elevator_cmd = 0.0;    // FCS原始指令(JSBSim方向), 直接写回 SetDeCmd
+    double aileron_cmd = 0.0;
+    double rudder_cmd = 0.0;
+    double pitch_trim_cmd = 0.0;
+    std::vector<double> throttle_cmd; // 各发动机油门指令, 按发动机序号
+};
+
+// --- 配平解缓存 ---
+// 以 "模型名 + 构型 + 量化的(航迹倾角, 滚转角, 高度, 速度, 重量)" 为键保存收敛后的配平解。
+// 航迹倾角与滚转角和构型一样只做精确匹配: 爬升/下滑或带坡度的配平解不会被当作平飞的解返回, 反之亦然。
+// 精确命中直接返回; 未命中时在同一模型、构型、航迹倾角与滚转角格内, 半径 maxNeighbourCells 格以内的条目中取最近的至多8个,
+// 只有最近的条目相距不超过1格, 或者这些条目在高度、速度、重量三个方向上都把查询点包在中间时,
+// 才按反距离加权插值(距离以量化格数计); 否则返回 false, 由调用方执行一次完整配平后 store()。
+// 只在一侧有邻居时外推出的解可能离真实配平很远, 宁可重新配平。
+// 可选持久化到文本文件。线程安全: 查找共享锁, 写入独占锁。
+class TrimCache {
+public:
+    struct Quantization {
+        double alt_m = 50.0;
+        double speed_kts = 2.0;
+        double weight_lbs = 100.0;
+        double gamma_deg = 0.5;
+        double phi_deg = 1.0;
+    };
+
+    struct Stats {
+        std::size_t exact_hits = 0;
+        std::size_t interpolated = 0;
+        std::size_t misses = 0;
+    };
+
+    TrimCache();
+    explicit TrimCache(const Quantization& quantization, double max_neighbour_cells = 4.0);
+    TrimCache(const TrimCache&) = delete;
+    TrimCache& operator=(const TrimCache&) = delete;
+
+    // 起落架放下为第0位, 襟翼指令按 0.1 量化放在第1位起
+    static std::uint32_t makeConfig(bool gear_down, double flap_cmd_norm);
+
+    bool lookup(const std::string& model, const TrimConditions& conditions, TrimSolution& solution);
+    void store(const std::string& model, const TrimConditions& conditions, const TrimSolution& solution);
+
+    // 文件格式: 首行为版本标记, 第二行 "quantization 高度 速度 重量 航迹倾角 滚转角" 为每格大小,
+    // 其后每行 "模型名 构型 航迹倾角格 滚转角格 高度格 速度格 重量格 7个解分量 发动机数 各发动机油门";
+    // load() 先完整解析整个文件, 全部成功且量化与本实例相同才合并到现有条目, 失败时缓存不变
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    std::size_t size() const;
+    Stats stats() const;
+    void clear();
+
+private:
+    struct Key {
+        std::string model;
+        std::uint32_t config;
+        std::int64_t gamma;
+        std::int64_t phi;
+        std::int64_t alt;
+        std::int64_t speed;
+        std::int64_t weight;
+        bool operator<(const Key& o) const;
+    };
+
+    Key makeKey(const std::string& model, const TrimConditions& conditions) const;
+
+    Quantization m_quant;
+    double m_maxNeighbourCells;
+
+    mutable std::shared_mutex m_mutex;
+    std::map<Key, TrimSolution> m_entries;
+
+    std::atomic<std::size_t> m_exactHits{0};
+    std::atomic<std::size_t> m_interpolated{0};
+    std::atomic<std::size_t> m_misses{0};
+};
+
+#endif // TRIM_CACHE_HPP
@@ -0,0 +1,53 @@
+// TripleBuffer.hpp
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+// --- 无锁三缓冲 ---
+// 一个写线程、一个读线程之间传递"最新完整帧":
+// 写线程在私有的 back 槽中组装数据, publish() 与 middle 槽原子交换;
+// 读线程 acquire() 时若有新帧则与 middle 槽交换, 之后独占 front 槽读取。
+// 双方都不会阻塞, 读线程永远看不到写了一半的数据。
+template<class T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // --- 写线程 ---
+    T& writeBuffer() { return m_buffers[m_back]; }
+
+    void publish() {
+        m_back = static_cast<std::uint8_t>(m_middle.exchange(static_cast<std::uint8_t>(m_back | FRESH), std::memory_order_acq_rel) & INDEX);
+    }
+
+    void publish(const T& value) {
+        writeBuffer() = value;
+        publish();
+    }
+
+    // --- 读线程 ---
+    // 返回最新发布的帧; 在下一次 acquire() 之前该引用保持有效且不会被改写
+    const T& acquire() {
+        if (m_middle.load(std::memory_order_relaxed) & FRESH) {
+            m_front = static_cast<std::uint8_t>(m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX);
+        }
+        return m_buffers[m_front];
+    }
+
+    bool hasNewFrame() const { return (m_middle.load(std::memory_order_relaxed) & FRESH) != 0; }
+
+private:
+    static constexpr std::uint8_t INDEX = 0x3;
+    static constexpr std::uint8_t FRESH = 0x4;
+
+    T m_buffers[3];
+    alignas(64) std::atomic<std::uint8_t> m_middle{1};
+    alignas(64) std::uint8_t m_back = 0;  // 仅写线程访问
+    alignas(64) std::uint8_t m_front = 2; // 仅读线程访问
+};
+
+#endif // TRIPLE_BUFFER_HPP
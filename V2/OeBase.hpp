@@ -3,8 +3,19 @@
 #define OE_BASE_HPP
 
 #include <cmath>
+#include <cstddef>
 #include <algorithm> // For std::max/min if needed
 
+// 批量核函数按编译目标选用 AVX2 (x86-64, -mavx2) 或 NEON (AArch64), 否则为标量实现;
+// 定义 OE_BASE_NO_SIMD 可强制使用标量实现
+#if !defined(OE_BASE_NO_SIMD) && defined(__AVX2__)
+#define OE_BASE_SIMD_AVX2 1
+#include <immintrin.h>
+#elif !defined(OE_BASE_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#define OE_BASE_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace oe_base {
 
 // --- 数学常量 ---
@@ -17,6 +28,22 @@ namespace angle {
     const double R2DCC = 180.0 / PI; // 弧度转度
 }
 
+// --- 单位转换 ---
+const double FT2M = 0.3048;             // 英尺转米
+const double M2FT = 1.0 / FT2M;         // 米转英尺
+const double NM2M = 1852.0;             // 海里转米
+const double KTS2MPS = 1852.0 / 3600.0; // 节转米/秒
+const double MPS2KTS = 3600.0 / 1852.0; // 米/秒转节
+const double LBS2KG = 0.45359237;       // 磅转千克
+const double KG2LBS = 1.0 / LBS2KG;     // 千克转磅
+
+// --- WGS-84 椭球 ---
+namespace wgs84 {
+    const double A = 6378137.0;              // 长半轴, 米
+    const double F = 1.0 / 298.257223563;    // 扁率
+    const double E2 = F * (2.0 - F);         // 第一偏心率平方
+}
+
 // --- 简单的三维向量类 ---
 class Vec3d {
 public:
@@ -30,11 +57,11 @@ public:
     double x() const { return v_x; }
     double y() const { return v_y; }
     double z() const { return v_z; }
-    
+
     double length() const {
         return std::sqrt(v_x * v_x + v_y * v_y + v_z * v_z);
     }
-    
+
     double length2() const {
         return v_x * v_x + v_y * v_y + v_z * v_z;
     }
@@ -51,20 +78,404 @@ inline T sign(const T& x) {
     return T(0);
 }
 
-// 确保角度在 -PI 到 +PI 之间
+// 无分支角度归一化到 [-PI, PI) / [-180, 180)
+inline double wrapRad(double angle) {
+    return angle - (2.0 * PI) * std::floor((angle + PI) * (1.0 / (2.0 * PI)));
+}
+
+inline double wrapDeg(double angle) {
+    return angle - 360.0 * std::floor((angle + 180.0) * (1.0 / 360.0));
+}
+
+// 确保角度在 -PI 到 +PI 之间(范围内的值原样返回, 不再逐圈循环)
 inline double aepcdRad(double angle) {
-    while (angle > PI) angle -= (2.0 * PI);
-    while (angle < -PI) angle += (2.0 * PI);
-    return angle;
+    return (angle > PI || angle < -PI) ? wrapRad(angle) : angle;
 }
 
 // 确保角度在 -180 到 +180 之间
 inline double aepcdDeg(double angle) {
-    while (angle > 180.0) angle -= 360.0;
-    while (angle < -180.0) angle += 360.0;
-    return angle;
+    return (angle > 180.0 || angle < -180.0) ? wrapDeg(angle) : angle;
+}
+
+// --- SIMD 通道 ---
+// 每种通道提供相同的静态操作, 批量核函数只写一次, 按通道宽度分块展开。
+// 三角函数采用同一组多项式(Cephes 系数), 各通道与尾部标量结果逐位一致。
+namespace simd {
+
+struct ScalarLane {
+    using V = double;
+    using M = bool;
+    static constexpr std::size_t WIDTH = 1;
+
+    static V load(const double* p) { return *p; }
+    static void store(double* p, V v) { *p = v; }
+    static V set(double x) { return x; }
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static V div(V a, V b) { return a / b; }
+    static V sqrt(V a) { return std::sqrt(a); }
+    static V floor(V a) { return std::floor(a); }
+    static V abs(V a) { return std::fabs(a); }
+    static V neg(V a) { return -a; }
+    static V min(V a, V b) { return a < b ? a : b; }
+    static V max(V a, V b) { return a > b ? a : b; }
+    static M gt(V a, V b) { return a > b; }
+    static M lt(V a, V b) { return a < b; }
+    static M eq(V a, V b) { return a == b; }
+    static M andMask(M a, M b) { return a && b; }
+    static M orMask(M a, M b) { return a || b; }
+    static V select(M m, V a, V b) { return m ? a : b; }
+};
+
+#if defined(OE_BASE_SIMD_AVX2)
+struct Avx2Lane {
+    using V = __m256d;
+    using M = __m256d;
+    static constexpr std::size_t WIDTH = 4;
+
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+    static V set(double x) { return _mm256_set1_pd(x); }
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm256_div_pd(a, b); }
+    static V sqrt(V a) { return _mm256_sqrt_pd(a); }
+    static V floor(V a) { return _mm256_floor_pd(a); }
+    static V abs(V a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static V neg(V a) { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+    static V min(V a, V b) { return _mm256_min_pd(a, b); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static M gt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static M lt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static M eq(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static M andMask(M a, M b) { return _mm256_and_pd(a, b); }
+    static M orMask(M a, M b) { return _mm256_or_pd(a, b); }
+    static V select(M m, V a, V b) { return _mm256_blendv_pd(b, a, m); }
+};
+using NativeLane = Avx2Lane;
+#elif defined(OE_BASE_SIMD_NEON)
+struct NeonLane {
+    using V = float64x2_t;
+    using M = uint64x2_t;
+    static constexpr std::size_t WIDTH = 2;
+
+    static V load(const double* p) { return vld1q_f64(p); }
+    static void store(double* p, V v) { vst1q_f64(p, v); }
+    static V set(double x) { return vdupq_n_f64(x); }
+    static V add(V a, V b) { return vaddq_f64(a, b); }
+    static V sub(V a, V b) { return vsubq_f64(a, b); }
+    static V mul(V a, V b) { return vmulq_f64(a, b); }
+    static V div(V a, V b) { return vdivq_f64(a, b); }
+    static V sqrt(V a) { return vsqrtq_f64(a); }
+    static V floor(V a) { return vrndmq_f64(a); }
+    static V abs(V a) { return vabsq_f64(a); }
+    static V neg(V a) { return vnegq_f64(a); }
+    static V min(V a, V b) { return vminq_f64(a, b); }
+    static V max(V a, V b) { return vmaxq_f64(a, b); }
+    static M gt(V a, V b) { return vcgtq_f64(a, b); }
+    static M lt(V a, V b) { return vcltq_f64(a, b); }
+    static M eq(V a, V b) { return vceqq_f64(a, b); }
+    static M andMask(M a, M b) { return vandq_u64(a, b); }
+    static M orMask(M a, M b) { return vorrq_u64(a, b); }
+    static V select(M m, V a, V b) { return vbslq_f64(m, a, b); }
+};
+using NativeLane = NeonLane;
+#else
+using NativeLane = ScalarLane;
+#endif
+
+// 以本机通道处理整块, 剩余元素逐个以标量通道处理; kernel(lane, i) 处理 [i, i + WIDTH)
+template<class Kernel>
+inline void forEachLane(std::size_t n, const Kernel& kernel) {
+    std::size_t i = 0;
+    for (; i + NativeLane::WIDTH <= n; i += NativeLane::WIDTH) kernel(NativeLane(), i);
+    for (; i < n; ++i) kernel(ScalarLane(), i);
+}
+
+template<class L>
+inline typename L::V wrap(typename L::V a, double half_turn) {
+    const typename L::V turn = L::set(2.0 * half_turn);
+    const typename L::V k = L::floor(L::mul(L::add(a, L::set(half_turn)), L::set(0.5 / half_turn)));
+    return L::sub(a, L::mul(turn, k));
+}
+
+// sin/cos: 按 PI/2 取整缩减到 [-PI/4, PI/4], 分三段减去 k*PI/2 保持精度
+template<class L>
+inline void sincos(typename L::V x, typename L::V& s, typename L::V& c) {
+    using V = typename L::V;
+    const V q = L::floor(L::add(L::mul(x, L::set(2.0 / PI)), L::set(0.5)));
+    V r = L::sub(x, L::mul(q, L::set(1.57079625129699707031)));
+    r = L::sub(r, L::mul(q, L::set(7.54978941586159635335e-08)));
+    r = L::sub(r, L::mul(q, L::set(5.39030285815811905290e-15)));
+    const V z = L::mul(r, r);
+
+    V ps = L::set(1.58962301576546568060e-10);
+    ps = L::add(L::mul(ps, z), L::set(-2.50507477628578072866e-8));
+    ps = L::add(L::mul(ps, z), L::set(2.75573136213857245213e-6));
+    ps = L::add(L::mul(ps, z), L::set(-1.98412698295895385996e-4));
+    ps = L::add(L::mul(ps, z), L::set(8.33333333332211858878e-3));
+    ps = L::add(L::mul(ps, z), L::set(-1.66666666666666307295e-1));
+    const V sr = L::add(r, L::mul(L::mul(r, z), ps));
+
+    V pc = L::set(-1.13585365213876817300e-11);
+    pc = L::add(L::mul(pc, z), L::set(2.08757008419747316778e-9));
+    pc = L::add(L::mul(pc, z), L::set(-2.75573141792967388112e-7));
+    pc = L::add(L::mul(pc, z), L::set(2.48015872888517045348e-5));
+    pc = L::add(L::mul(pc, z), L::set(-1.38888888888730564116e-3));
+    pc = L::add(L::mul(pc, z), L::set(4.16666666666665929218e-2));
+    const V cr = L::add(L::sub(L::set(1.0), L::mul(L::set(0.5), z)), L::mul(L::mul(z, z), pc));
+
+    // 象限 q mod 4: 0 (s, c), 1 (c, -s), 2 (-s, -c), 3 (-c, s)
+    const V quadrant = L::sub(q, L::mul(L::set(4.0), L::floor(L::mul(q, L::set(0.25)))));
+    const typename L::M odd = L::orMask(L::eq(quadrant, L::set(1.0)), L::eq(quadrant, L::set(3.0)));
+    const V sv = L::select(odd, cr, sr);
+    const V cv = L::select(odd, sr, cr);
+    s = L::select(L::gt(quadrant, L::set(1.5)), L::neg(sv), sv);
+    c = L::select(L::andMask(L::gt(quadrant, L::set(0.5)), L::lt(quadrant, L::set(2.5))), L::neg(cv), cv);
+}
+
+// atan: 缩减到 [0, 0.66] 后用有理逼近
+template<class L>
+inline typename L::V atan(typename L::V x) {
+    using V = typename L::V;
+    const V ax = L::abs(x);
+    const typename L::M big = L::gt(ax, L::set(2.41421356237309504880)); // tan(3PI/8)
+    const typename L::M mid = L::gt(ax, L::set(0.66));
+    const V num = L::select(big, L::set(-1.0), L::select(mid, L::sub(ax, L::set(1.0)), ax));
+    const V den = L::select(big, ax, L::select(mid, L::add(ax, L::set(1.0)), L::set(1.0)));
+    const V xr = L::div(num, den);
+    const V base = L::select(big, L::set(PI / 2.0), L::select(mid, L::set(PI / 4.0), L::set(0.0)));
+    const V extra = L::select(big, L::set(6.123233995736765886130e-17),
+                              L::select(mid, L::set(3.061616997868382943065e-17), L::set(0.0)));
+
+    const V z = L::mul(xr, xr);
+    V p = L::set(-8.750608600031904122785e-1);
+    p = L::add(L::mul(p, z), L::set(-1.615753718733365076637e1));
+    p = L::add(L::mul(p, z), L::set(-7.500855792314704667340e1));
+    p = L::add(L::mul(p, z), L::set(-1.228866684490136173410e2));
+    p = L::add(L::mul(p, z), L::set(-6.485021904942025371773e1));
+    V q = L::add(z, L::set(2.485846490142306297962e1));
+    q = L::add(L::mul(q, z), L::set(1.650270098316988542046e2));
+    q = L::add(L::mul(q, z), L::set(4.328810604912902668951e2));
+    q = L::add(L::mul(q, z), L::set(4.853903996359136964868e2));
+    q = L::add(L::mul(q, z), L::set(1.945506571482613964425e2));
+
+    const V t = L::add(L::mul(xr, L::div(L::mul(z, p), q)), xr);
+    const V y = L::add(base, L::add(t, extra));
+    return L::select(L::lt(x, L::set(0.0)), L::neg(y), y);
+}
+
+template<class L>
+inline typename L::V atan2(typename L::V y, typename L::V x) {
+    using V = typename L::V;
+    const V ax = L::abs(x);
+    const V ay = L::abs(y);
+    const V hi = L::max(ax, ay);
+    const V lo = L::min(ax, ay);
+    const typename L::M zero = L::eq(hi, L::set(0.0));
+    V r = atan<L>(L::div(L::select(zero, L::set(0.0), lo), L::select(zero, L::set(1.0), hi)));
+    r = L::select(L::gt(ay, ax), L::sub(L::set(PI / 2.0), r), r);
+    r = L::select(L::lt(x, L::set(0.0)), L::sub(L::set(PI), r), r);
+    return L::select(L::lt(y, L::set(0.0)), L::neg(r), r);
+}
+
+template<class L>
+inline typename L::V asin(typename L::V x) {
+    const typename L::V one = L::set(1.0);
+    const typename L::V c = L::sqrt(L::max(L::set(0.0), L::mul(L::sub(one, x), L::add(one, x))));
+    return atan2<L>(x, c);
 }
 
+} // namespace simd
+
+// --- 批量核函数 ---
+// 输入输出均为长度 n 的连续数组(如 FleetStateSoA 的字段), 输出可与输入为同一数组。
+namespace batch {
+
+// 单位转换: out = in * factor, factor 取上方的 FT2M、KTS2MPS、angle::D2RCC 等
+inline void scale(const double* in, double* out, std::size_t n, double factor) {
+    simd::forEachLane(n, [&](auto lane, std::size_t i) {
+        using L = decltype(lane);
+        L::store(out + i, L::mul(L::load(in + i), L::set(factor)));
+    });
+}
+
+// 无分支角度归一化到 [-PI, PI) / [-180, 180)
+inline void wrapRad(const double* in, double* out, std::size_t n) {
+    simd::forEachLane(n, [&](auto lane, std::size_t i) {
+        using L = decltype(lane);
+        L::store(out + i, simd::wrap<L>(L::load(in + i), PI));
+    });
+}
+
+inline void wrapDeg(const double* in, double* out, std::size_t n) {
+    simd::forEachLane(n, [&](auto lane, std::size_t i) {
+        using L = decltype(lane);
+        L::store(out + i, simd::wrap<L>(L::load(in + i), 180.0));
+    });
+}
+
+namespace detail {
+
+template<class L>
+inline void geodeticToEcef(const double* lat_deg, const double* lon_deg, const double* alt_m,
+                           typename L::V& x, typename L::V& y, typename L::V& z) {
+    typename L::V slat, clat, slon, clon;
+    simd::sincos<L>(L::mul(L::load(lat_deg), L::set(angle::D2RCC)), slat, clat);
+    simd::sincos<L>(L::mul(L::load(lon_deg), L::set(angle::D2RCC)), slon, clon);
+    const typename L::V h = L::load(alt_m);
+    const typename L::V rn = L::div(L::set(wgs84::A),
+                                    L::sqrt(L::sub(L::set(1.0), L::mul(L::set(wgs84::E2), L::mul(slat, slat)))));
+    const typename L::V rc = L::mul(L::add(rn, h), clat);
+    x = L::mul(rc, clon);
+    y = L::mul(rc, slon);
+    z = L::mul(L::add(L::mul(rn, L::set(1.0 - wgs84::E2)), h), slat);
+}
+
+} // namespace detail
+
+// 大地坐标(纬度/经度为度, 高度为米) -> WGS-84 地心地固坐标(米)
+inline void geodeticToEcef(const double* lat_deg, const double* lon_deg, const double* alt_m,
+                           double* x, double* y, double* z, std::size_t n) {
+    simd::forEachLane(n, [&](auto lane, std::size_t i) {
+        using L = decltype(lane);
+        typename L::V vx, vy, vz;
+        detail::geodeticToEcef<L>(lat_deg + i, lon_deg + i, alt_m + i, vx, vy, vz);
+        L::store(x + i, vx);
+        L::store(y + i, vy);
+        L::store(z + i, vz);
+    });
+}
+
+// 场景原点: 本地北-东-地坐标系的原点与 ECEF -> NED 旋转矩阵
+struct NedOrigin {
+    double ecef[3] = {0.0, 0.0, 0.0};
+    double rot[9] = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0}; // 行主序
+
+    static NedOrigin fromGeodetic(double lat_deg, double lon_deg, double alt_m) {
+        NedOrigin o;
+        geodeticToEcef(&lat_deg, &lon_deg, &alt_m, &o.ecef[0], &o.ecef[1], &o.ecef[2], 1);
+        double slat, clat, slon, clon;
+        simd::sincos<simd::ScalarLane>(lat_deg * angle::D2RCC, slat, clat);
+        simd::sincos<simd::ScalarLane>(lon_deg * angle::D2RCC, slon, clon);
+        const double r[9] = {-slat * clon, -slat * slon, clat,
+                             -slon, clon, 0.0,
+                             -clat * clon, -clat * slon, -slat};
+        std::copy(r, r + 9, o.rot);
+        return o;
+    }
+};
+
+namespace detail {
+
+template<class L>
+inline void ecefToNed(const NedOrigin& origin, typename L::V x, typename L::V y, typename L::V z,
+                      double* north, double* east, double* down) {
+    const typename L::V dx = L::sub(x, L::set(origin.ecef[0]));
+    const typename L::V dy = L::sub(y, L::set(origin.ecef[1]));
+    const typename L::V dz = L::sub(z, L::set(origin.ecef[2]));
+    const double* r = origin.rot;
+    L::store(north, L::add(L::add(L::mul(L::set(r[0]), dx), L::mul(L::set(r[1]), dy)), L::mul(L::set(r[2]), dz)));
+    L::store(east, L::add(L::mul(L::set(r[3]), dx), L::mul(L::set(r[4]), dy)));
+    L::store(down, L::add(L::add(L::mul(L::set(r[6]), dx), L::mul(L::set(r[7]), dy)), L::mul(L::set(r[8]), dz)));
+}
+
+} // namespace detail
+
+inline void ecefToNed(const NedOrigin& origin, const double* x, const double* y, const double* z,
+                      double* north, double* east, double* down, std::size_t n) {
+    simd::forEachLane(n, [&](auto lane, std::size_t i) {
+        using L = decltype(lane);
+        detail::ecefToNed<L>(origin, L::load(x + i), L::load(y + i), L::load(z + i), north + i, east + i, down + i);
+    });
+}
+
+// 大地坐标 -> 相对场景原点的本地北-东-地(米), 一次遍历完成 ECEF 与旋转
+inline void geodeticToNed(const NedOrigin& origin, const double* lat_deg, const double* lon_deg, const double* alt_m,
+                          double* north, double* east, double* down, std::size_t n) {
+    simd::forEachLane(n, [&](auto lane, std::size_t i) {
+        using L = decltype(lane);
+        typename L::V x, y, z;
+        detail::geodeticToEcef<L>(lat_deg + i, lon_deg + i, alt_m + i, x, y, z);
+        detail::ecefToNed<L>(origin, x, y, z, north + i, east + i, down + i);
+    });
+}
+
+// 欧拉角(滚转/俯仰/偏航, 弧度, Z-Y-X 顺序) <-> 四元数(机体到本地, 标量在前)
+inline void eulerToQuat(const double* roll, const double* pitch, const double* yaw,
+                        double* qw, double* qx, double* qy, double* qz, std::size_t n) {
+    simd::forEachLane(n, [&](auto lane, std::size_t i) {
+        using L = decltype(lane);
+        typename L::V sr, cr, sp, cp, sy, cy;
+        simd::sincos<L>(L::mul(L::load(roll + i), L::set(0.5)), sr, cr);
+        simd::sincos<L>(L::mul(L::load(pitch + i), L::set(0.5)), sp, cp);
+        simd::sincos<L>(L::mul(L::load(yaw + i), L::set(0.5)), sy, cy);
+        const typename L::V cpcy = L::mul(cp, cy), spsy = L::mul(sp, sy);
+        const typename L::V cpsy = L::mul(cp, sy), spcy = L::mul(sp, cy);
+        L::store(qw + i, L::add(L::mul(cr, cpcy), L::mul(sr, spsy)));
+        L::store(qx + i, L::sub(L::mul(sr, cpcy), L::mul(cr, spsy)));
+        L::store(qy + i, L::add(L::mul(cr, spcy), L::mul(sr, cpsy)));
+        L::store(qz + i, L::sub(L::mul(cr, cpsy), L::mul(sr, spcy)));
+    });
+}
+
+inline void quatToEuler(const double* qw, const double* qx, const double* qy, const double* qz,
+                        double* roll, double* pitch, double* yaw, std::size_t n) {
+    simd::forEachLane(n, [&](auto lane, std::size_t i) {
+        using L = decltype(lane);
+        const typename L::V w = L::load(qw + i), x = L::load(qx + i), y = L::load(qy + i), z = L::load(qz + i);
+        const typename L::V one = L::set(1.0), two = L::set(2.0);
+        const typename L::V yy = L::mul(y, y);
+        const typename L::V r = simd::atan2<L>(L::mul(two, L::add(L::mul(w, x), L::mul(y, z))),
+                                               L::sub(one, L::mul(two, L::add(L::mul(x, x), yy))));
+        const typename L::V sp = L::mul(two, L::sub(L::mul(w, y), L::mul(z, x)));
+        const typename L::V p = simd::asin<L>(L::max(L::set(-1.0), L::min(one, sp)));
+        const typename L::V h = simd::atan2<L>(L::mul(two, L::add(L::mul(w, z), L::mul(x, y))),
+                                               L::sub(one, L::mul(two, L::add(yy, L::mul(z, z)))));
+        L::store(roll + i, r);
+        L::store(pitch + i, p);
+        L::store(yaw + i, h);
+    });
+}
+
+// 欧拉角 <-> 方向余弦矩阵(机体到本地, 即 JSBSim 的 Tb2l); dcm[k] 为第 k 个元素(行主序)的数组
+inline void eulerToDcm(const double* roll, const double* pitch, const double* yaw, double* const dcm[9], std::size_t n) {
+    simd::forEachLane(n, [&](auto lane, std::size_t i) {
+        using L = decltype(lane);
+        typename L::V sr, cr, sp, cp, sy, cy;
+        simd::sincos<L>(L::load(roll + i), sr, cr);
+        simd::sincos<L>(L::load(pitch + i), sp, cp);
+        simd::sincos<L>(L::load(yaw + i), sy, cy);
+        const typename L::V srsp = L::mul(sr, sp), crsp = L::mul(cr, sp);
+        L::store(dcm[0] + i, L::mul(cp, cy));
+        L::store(dcm[1] + i, L::sub(L::mul(srsp, cy), L::mul(cr, sy)));
+        L::store(dcm[2] + i, L::add(L::mul(crsp, cy), L::mul(sr, sy)));
+        L::store(dcm[3] + i, L::mul(cp, sy));
+        L::store(dcm[4] + i, L::add(L::mul(srsp, sy), L::mul(cr, cy)));
+        L::store(dcm[5] + i, L::sub(L::mul(crsp, sy), L::mul(sr, cy)));
+        L::store(dcm[6] + i, L::neg(sp));
+        L::store(dcm[7] + i, L::mul(sr, cp));
+        L::store(dcm[8] + i, L::mul(cr, cp));
+    });
+}
+
+inline void dcmToEuler(const double* const dcm[9], double* roll, double* pitch, double* yaw, std::size_t n) {
+    simd::forEachLane(n, [&](auto lane, std::size_t i) {
+        using L = decltype(lane);
+        const typename L::V m20 = L::load(dcm[6] + i);
+        const typename L::V r = simd::atan2<L>(L::load(dcm[7] + i), L::load(dcm[8] + i));
+        const typename L::V p = simd::asin<L>(L::max(L::set(-1.0), L::min(L::set(1.0), L::neg(m20))));
+        const typename L::V h = simd::atan2<L>(L::load(dcm[3] + i), L::load(dcm[0] + i));
+        L::store(roll + i, r);
+        L::store(pitch + i, p);
+        L::store(yaw + i, h);
+    });
+}
+
+} // namespace batch
+
 } // namespace oe_base
 
-#endif // OE_BASE_HPP
\ No newline at end of file
+#endif // OE_BASE_HPP
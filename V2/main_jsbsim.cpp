@@ -1,13 +1,14 @@
 // main_jsbsim.cpp
-// 编译: g++ main_jsbsim.cpp StandaloneJSBSimModel.cpp -o JsbSimApp -std=c++17 -I/path/to/jsbsim/include -L/path/to/jsbsim/lib -lJSBSim
+// 编译: g++ main_jsbsim.cpp StandaloneJSBSim.cpp ../ModelTemplateCache.cpp ../TrimCache.cpp ../TelemetryRecorder.cpp ../FrameScheduler.cpp -o JsbSimApp -std=c++17 -pthread -I/path/to/jsbsim/include -L/path/to/jsbsim/lib -lJSBSim
 // 运行前确保JSBSIM_ROOT_PATH和AIRCRAFT_MODEL是正确的
 
 #include <iostream>
 #include <iomanip>
-#include <fstream>
 #include <thread>
 #include <chrono>
 #include "StandaloneJSBSim.hpp" // 和之前不同的头文件
+#include "../TelemetryRecorder.hpp"
+#include "../FrameScheduler.hpp"
 
 // !!! 用户需要根据自己的环境修改这两个路径 !!!
 const std::string JSBSIM_ROOT_PATH = "/path/to/your/jsbsim/data"; // 例如: "/usr/local/share/JSBSim" 或 "./jsbsim"
@@ -30,15 +31,28 @@ int main() {
         return 1;
     }
 
-    // --- 3. 准备日志文件 ---
-    std::ofstream outputFile("jsbsim_log.csv");
-    outputFile << "Time,Altitude_m,TAS_kts,Mach,G_Load,Roll_deg,Pitch_deg,Yaw_deg,Alpha_deg,Beta_deg\n";
+    // --- 3. 准备遥测记录器 ---
+    // 后台线程写二进制列式文件, 可用 telemetry_export 离线转换为CSV
+    TelemetryRecorder recorder;
+    if (!recorder.openForState("jsbsim_log.jtlm", {"altitude_sl_m", "calibrated_airspeed_kts", "mach", "g_load",
+                                                    "roll_rad", "pitch_rad", "yaw_rad", "alpha_rad", "beta_rad"})) {
+        return 1;
+    }
 
     // --- 4. 仿真循环 ---
     const double dt = 1.0 / 60.0;
     std::cout << "Simulation started. Running for 60 seconds..." << std::endl;
 
+    // 如果需要实时仿真(如硬件在环)，将 REAL_TIME 设为 true
+    // 调度器按绝对时间轴节拍推进；某帧超时后 waitNextFrame() 返回需补跑的帧数
+    const bool REAL_TIME = false;
+    FrameScheduler scheduler(1.0 / dt, FrameScheduler::OverrunPolicy::CatchUp);
+    int pendingFrames = 0;
+    if (REAL_TIME) scheduler.start();
+
     for (double simTime = 0.0; simTime <= 60.0; simTime += dt) {
+        if (REAL_TIME && pendingFrames == 0) pendingFrames = scheduler.waitNextFrame();
+
         // --- 简单的机动指令 ---
         // 在5-15秒期间，施加一个滚转指令
         if (simTime > 5.0 && simTime < 15.0) {
@@ -63,24 +77,20 @@ int main() {
                       << std::endl;
         }
 
-        outputFile << std::fixed << std::setprecision(4)
-                   << simTime << ","
-                   << state.altitude_sl_m << ","
-                   << state.calibrated_airspeed_kts << ","
-                   << state.mach << ","
-                   << state.g_load << ","
-                   << state.roll_rad * oe_base::angle::R2DCC << ","
-                   << state.pitch_rad * oe_base::angle::R2DCC << ","
-                   << state.yaw_rad * oe_base::angle::R2DCC << ","
-                   << state.alpha_rad * oe_base::angle::R2DCC << ","
-                   << state.beta_rad * oe_base::angle::R2DCC << "\n";
-        
-        // 如果需要实时仿真，可以取消下面的注释
-        // std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<long long>(dt * 1000)));
+        recorder.push(simTime, 0, state);
+
+        if (REAL_TIME && --pendingFrames == 0) scheduler.endFrame();
     }
     
-    outputFile.close();
-    std::cout << "Simulation finished. Log file 'jsbsim_log.csv' has been saved." << std::endl;
+    recorder.close();
+    if (REAL_TIME) {
+        const FrameScheduler::Stats& timing = scheduler.stats();
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Timing: missed deadlines " << timing.missed_deadlines << ", dropped " << timing.dropped_frames
+                  << ", jitter p99 " << timing.jitterPercentileUs(99.0) << "us, max " << timing.max_jitter_us
+                  << "us, max overrun " << timing.max_overrun_us << "us" << std::endl;
+    }
+    std::cout << "Simulation finished. Telemetry file 'jsbsim_log.jtlm' has been saved." << std::endl;
 
     return 0;
 }
\ No newline at end of file
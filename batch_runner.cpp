@@ -0,0 +1,231 @@
+// batch_runner.cpp
+// 无界面批处理: 读取场景文件, 在线程池上并发、以最快速度运行, 每个场景输出一个CSV, 另写汇总 summary.csv
+// 编译: g++ batch_runner.cpp ScenarioFile.cpp StandaloneJSBSimModel.cpp ModelTemplateCache.cpp TrimCache.cpp -o batch_runner -std=c++17 -O2 -pthread -I/path/to/jsbsim/include -L/path/to/jsbsim/lib -lJSBSim
+// 用法: batch_runner [-j 线程数] [-o 输出目录] [--root JSBSim根目录] <场景.ini> [场景.ini ...]
+// 返回值: 全部成功为0, 有场景失败为2, 参数错误为1
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "JSBSimStateFields.hpp"
+#include "ModelTemplateCache.hpp"
+#include "ScenarioFile.hpp"
+#include "StandaloneJSBSimModel.hpp"
+
+struct ScenarioResult {
+    bool ok = false;
+    std::string error;
+    long long steps = 0;
+    double sim_time_s = 0.0;
+    double wall_time_s = 0.0;
+    double final_altitude_m = 0.0;
+    double min_g_load = 0.0;
+    double max_g_load = 0.0;
+    bool ground_contact = false;
+};
+
+namespace {
+
+// RFC 4180 字段: 含逗号、引号或换行时加引号, 内部引号加倍
+std::string csvField(const std::string& v) {
+    if (v.find_first_of(",\"\r\n") == std::string::npos) return v;
+    std::string out = "\"";
+    for (char c : v) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+    return out;
+}
+
+bool runScenario(StandaloneJSBSimModel& aircraft, const Scenario& sc, const std::string& root,
+                 const std::string& csv_path, ScenarioResult& r) {
+    const auto start = std::chrono::steady_clock::now();
+    if (!aircraft.init(root, sc.aircraft)) {
+        r.error = "init failed";
+        return false;
+    }
+    aircraft.setInternalRate(sc.internal_rate_hz);
+    aircraft.setInitialConditions(sc.lat_deg, sc.lon_deg, sc.alt_m, sc.hdg_deg, sc.speed_kts);
+    aircraft.applyControls(sc.controlsAt(0.0));
+    if (!aircraft.runInitialConditions()) {
+        r.error = "RunIC failed";
+        return false;
+    }
+
+    std::FILE* out = std::fopen(csv_path.c_str(), "w");
+    if (!out) {
+        r.error = "cannot open " + csv_path;
+        return false;
+    }
+    std::vector<StateFieldRef> fields;
+    std::fprintf(out, "time");
+    for (const std::string& name : sc.output_fields) {
+        fields.push_back(findStateField(name));
+        std::fprintf(out, ",%s", name.c_str());
+    }
+    std::fputc('\n', out);
+
+    auto writeRow = [&](double t) {
+        const JSBSimAircraftState& s = aircraft.getState();
+        std::fprintf(out, "%.6f", t);
+        for (const StateFieldRef& f : fields) std::fprintf(out, ",%.10g", f(s));
+        std::fputc('\n', out);
+    };
+
+    const JSBSimAircraftState& s0 = aircraft.getState();
+    r.min_g_load = r.max_g_load = s0.g_load;
+    writeRow(0.0);
+
+    // 输出按时间轴 k / output_rate_hz 取最近的帧, 0 表示每帧输出
+    const double output_period = sc.output_rate_hz > 0.0 ? 1.0 / sc.output_rate_hz : 0.0;
+    double next_output = output_period;
+    const long long steps = static_cast<long long>(std::ceil(sc.duration_s / sc.dt - 1e-9));
+    for (long long n = 0; n < steps; ++n) {
+        const double t = n * sc.dt;
+        aircraft.applyControls(sc.controlsAt(t));
+        aircraft.update(sc.dt);
+
+        const double t_next = (n + 1) * sc.dt;
+        const JSBSimAircraftState& s = aircraft.getState();
+        r.min_g_load = std::min(r.min_g_load, s.g_load);
+        r.max_g_load = std::max(r.max_g_load, s.g_load);
+        r.ground_contact = r.ground_contact || s.on_ground;
+        if (t_next + 0.5 * sc.dt >= next_output) {
+            writeRow(t_next);
+            next_output += output_period;
+            if (next_output <= t_next) next_output = t_next + output_period;
+        }
+    }
+    std::fclose(out);
+
+    r.steps = steps;
+    r.sim_time_s = steps * sc.dt;
+    r.final_altitude_m = aircraft.getState().altitude_sl_m;
+    r.wall_time_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    std::string out_dir = "batch_results";
+    std::string root_override;
+    std::vector<std::string> files;
+
+    for (int a = 1; a < argc; ++a) {
+        const std::string arg = argv[a];
+        if (arg == "-j" && a + 1 < argc) {
+            const char* value = argv[++a];
+            char* end = nullptr;
+            const long n = std::strtol(value, &end, 10);
+            if (end == value || *end != '\0' || n < 1 || n > 4096) {
+                std::cerr << "-j expects a thread count between 1 and 4096, got '" << value << "'" << std::endl;
+                return 1;
+            }
+            threads = static_cast<unsigned>(n);
+        } else if (arg == "-o" && a + 1 < argc) out_dir = argv[++a];
+        else if (arg == "--root" && a + 1 < argc) root_override = argv[++a];
+        else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 1;
+        } else files.push_back(arg);
+    }
+    if (files.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [-j threads] [-o out_dir] [--root jsbsim_root] <scenario.ini> [...]" << std::endl;
+        return 1;
+    }
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // --- 先读入并校验所有场景, 有错误时不开始运行 ---
+    std::vector<Scenario> scenarios(files.size());
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        std::string error;
+        if (!loadScenarioFile(files[i], scenarios[i], error)) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+        if (!root_override.empty()) scenarios[i].jsbsim_root = root_override;
+        if (scenarios[i].jsbsim_root.empty()) {
+            std::cerr << files[i] << ": no jsbsim_root (set it in [scenario] or pass --root)" << std::endl;
+            return 1;
+        }
+    }
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+            if (scenarios[i].name == scenarios[j].name) {
+                std::cerr << files[i] << ": duplicate scenario name '" << scenarios[i].name << "'" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(out_dir, ec);
+    if (ec) {
+        std::cerr << "Failed to create output directory " << out_dir << ": " << ec.message() << std::endl;
+        return 1;
+    }
+
+    // --- 线程池: 各线程按序号领取场景 ---
+    // 每个场景使用新建的模型实例和执行器, 结果不受同一线程上先前运行的场景影响
+    std::vector<ScenarioResult> results(scenarios.size());
+    std::atomic<std::size_t> next{0};
+    std::mutex log_mutex;
+    const auto start = std::chrono::steady_clock::now();
+
+    ModelTemplateCache::setJSBSimDebugLevel(0); // 进程全局, 工作线程以 setVerbose(false) 加载时不再修改
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < std::min<std::size_t>(threads, scenarios.size()); ++t) {
+        workers.emplace_back([&] {
+            for (std::size_t i = next.fetch_add(1); i < scenarios.size(); i = next.fetch_add(1)) {
+                const Scenario& sc = scenarios[i];
+                ScenarioResult& r = results[i];
+                StandaloneJSBSimModel aircraft;
+                aircraft.setVerbose(false);
+                r.ok = runScenario(aircraft, sc, sc.jsbsim_root, out_dir + "/" + sc.name + ".csv", r);
+
+                std::lock_guard<std::mutex> lock(log_mutex);
+                std::cout << (r.ok ? "[ OK ] " : "[FAIL] ") << sc.name;
+                if (r.ok) std::cout << " (" << r.sim_time_s << " s in " << r.wall_time_s << " s)";
+                else std::cout << ": " << r.error;
+                std::cout << std::endl;
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // --- 汇总, 按命令行顺序 ---
+    const std::string summary_path = out_dir + "/summary.csv";
+    std::FILE* summary = std::fopen(summary_path.c_str(), "w");
+    if (!summary) {
+        std::cerr << "Failed to open " << summary_path << std::endl;
+        return 1;
+    }
+    std::fprintf(summary, "scenario,source,ok,steps,sim_time_s,wall_time_s,final_altitude_m,min_g_load,max_g_load,ground_contact,error\n");
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        const ScenarioResult& r = results[i];
+        if (!r.ok) ++failed;
+        std::fprintf(summary, "%s,%s,%d,%lld,%.6f,%.6f,%.9g,%.9g,%.9g,%d,%s\n",
+                     csvField(scenarios[i].name).c_str(), csvField(scenarios[i].source_path).c_str(), r.ok ? 1 : 0,
+                     r.steps, r.sim_time_s, r.wall_time_s, r.final_altitude_m, r.min_g_load, r.max_g_load,
+                     r.ground_contact ? 1 : 0, csvField(r.error).c_str());
+    }
+    std::fclose(summary);
+
+    std::cout << scenarios.size() - failed << "/" << scenarios.size() << " scenarios passed in " << wall
+              << " s on " << threads << " threads, results in " << out_dir << std::endl;
+    return failed ? 2 : 0;
+}
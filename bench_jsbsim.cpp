@@ -0,0 +1,445 @@
+// bench_jsbsim.cpp
+// 编译: g++ -DJSBSIM_ENABLE_PERF_STATS bench_jsbsim.cpp StandaloneJSBSimModel.cpp V2/StandaloneJSBSim.cpp ModelTemplateCache.cpp TrimCache.cpp SpatialIndex.cpp -o JsbSimBench -std=c++17 -O2 -pthread -I/path/to/jsbsim/include -L/path/to/jsbsim/lib -lJSBSim
+// 用法: JsbSimBench <jsbsim_root_dir> <aircraft_model> [最大实例数] [结果JSON文件]
+// 结果同时打印到屏幕并写入JSON(默认 bench_results.json), 便于在版本之间比对回归。
+// 本程序替换了全局 operator new, 统计稳态 update() 与状态拷贝中的堆分配次数(应为0, 否则返回非零)。
+// update() 各阶段的耗时取自包装类自身的 JSBSIM_PERF_SCOPE 计时(PerfStats.hpp), 因此所有源文件都须以
+// -DJSBSIM_ENABLE_PERF_STATS 编译。
+// 最后以合成机群测试空间索引的查询开销随飞机数的增长(不依赖 JSBSim)。
+
+#define JSBSIM_COUNT_ALLOCATIONS
+#include "AllocationCounter.hpp"
+
+#ifndef JSBSIM_ENABLE_PERF_STATS
+#error "bench_jsbsim: compile every source file with -DJSBSIM_ENABLE_PERF_STATS"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "StandaloneJSBSimModel.hpp"
+#include "V2/StandaloneJSBSim.hpp"
+#include "ModelTemplateCache.hpp"
+#include "FleetExecutor.hpp"
+#include "SpatialIndex.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// 一组样本的统计量
+struct Summary {
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+// 包装类 PerfStats 中的一个阶段; 百分位数为最近 PerfCounters::WINDOW 次调用
+Summary summarize(const PerfPhaseStats& phase) {
+    Summary s;
+    s.mean = phase.meanUs();
+    s.p50 = phase.p50_us;
+    s.p99 = phase.p99_us;
+    s.max = phase.max_us;
+    return s;
+}
+
+Summary summarize(std::vector<double> samples) {
+    Summary s;
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double v : samples) sum += v;
+    s.mean = sum / samples.size();
+    s.p50 = samples[samples.size() / 2];
+    s.p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    s.max = samples.back();
+    return s;
+}
+
+std::string toJson(const Summary& s) {
+    std::ostringstream out;
+    out << std::setprecision(6) << "{\"mean\": " << s.mean << ", \"p50\": " << s.p50
+        << ", \"p99\": " << s.p99 << ", \"max\": " << s.max << "}";
+    return out.str();
+}
+
+struct ScalingPoint {
+    std::size_t aircraft = 0;
+    unsigned threads = 0;
+    double frame_ms = 0.0;
+    double steps_per_sec = 0.0;
+};
+
+struct WrapperResult {
+    std::string name;
+    int instances = 0;
+    double cold_init_ms = 0.0;      // 每实例
+    double prewarm_ms = 0.0;        // 全部实例
+    double cached_init_ms = 0.0;    // 每实例
+    Summary run_ic_ms;
+    // update() 各阶段, 取自 getPerfStats(); 没有配平模型的包装类 trims 为0
+    Summary update_trims_us;
+    Summary run_us;
+    Summary update_state_us;
+    Summary update_us;              // 完整 update()
+    std::uint64_t update_allocations = 0;     // 稳态 update() 的堆分配总次数
+    std::uint64_t state_copy_allocations = 0; // 状态拷贝进环形缓冲的堆分配总次数
+    std::vector<ScalingPoint> scaling;
+};
+
+// 空间索引: 每帧 commit + 每架飞机一次半径查询和一次k近邻 + 一次全机群配对
+struct SpatialPoint {
+    std::size_t aircraft = 0;
+    double commit_us = 0.0;     // 每帧
+    double radius_us = 0.0;     // 每帧, 全部飞机
+    double nearest_us = 0.0;    // 每帧, 全部飞机
+    double pairs_us = 0.0;      // 每帧
+    double brute_pairs_us = 0.0; // O(N^2) 两两比较, 仅较小机群
+    double ns_per_aircraft = 0.0; // (commit + radius + nearest + pairs) / 飞机数
+    double moved_fraction = 0.0;  // commit 中跨格移动的比例
+    double mean_hits = 0.0;       // 每次半径查询的命中数
+};
+
+const double DT = 1.0 / 60.0;
+
+template<class Model>
+void spawn(Model& m, const std::string& root, const std::string& model, ModelTemplateCache& cache, std::size_t index) {
+    m.setModelCache(&cache);
+    if (!m.init(root, model)) return;
+    m.setInitialConditions(34.0, -118.0 + index * 0.01, 1524.0, 90.0, 100.0);
+    m.runInitialConditions();
+    m.setThrottles(0.8);
+}
+
+// --- 启动开销: 冷加载 vs 缓存复用 ---
+template<class Model>
+bool benchStartup(WrapperResult& r, const std::string& root, const std::string& model, int count, ModelTemplateCache& cache) {
+    // 冷加载: 每个实例完整读盘并解析XML
+    auto start = Clock::now();
+    {
+        std::vector<std::unique_ptr<Model>> fleet;
+        for (int i = 0; i < count; ++i) {
+            fleet.push_back(std::make_unique<Model>());
+            if (!fleet.back()->init(root, model)) return false;
+        }
+    }
+    r.cold_init_ms = elapsedMs(start) / count;
+
+    // 预加载后全部从缓存取得
+    start = Clock::now();
+    cache.prewarm(root, model, static_cast<std::size_t>(count), Model::cacheLoadOptions());
+    r.prewarm_ms = elapsedMs(start);
+
+    std::vector<double> run_ic;
+    start = Clock::now();
+    std::vector<std::unique_ptr<Model>> fleet;
+    for (int i = 0; i < count; ++i) {
+        fleet.push_back(std::make_unique<Model>());
+        fleet.back()->setModelCache(&cache);
+        if (!fleet.back()->init(root, model)) return false;
+    }
+    r.cached_init_ms = elapsedMs(start) / count;
+
+    // --- runInitialConditions() ---
+    for (int i = 0; i < count; ++i) {
+        fleet[i]->setInitialConditions(34.0, -118.0 + i * 0.01, 1524.0, 90.0, 100.0);
+        const auto t0 = Clock::now();
+        fleet[i]->runInitialConditions();
+        run_ic.push_back(elapsedMs(t0));
+    }
+    r.run_ic_ms = summarize(run_ic);
+    r.instances = count;
+    return true;
+}
+
+// --- 单机 update() 分段计时 ---
+// 完整的 update() 由包装类内部的 JSBSIM_PERF_SCOPE 分段计时, 这里只驱动并读取 getPerfStats()
+template<class Model>
+void benchUpdatePhases(WrapperResult& r, const std::string& root, const std::string& model, ModelTemplateCache& cache) {
+    const int warmup = 1000;
+    const int frames = 3000;
+    Model m;
+    spawn(m, root, model, cache, 0);
+    for (int i = 0; i < warmup; ++i) m.update(DT);
+
+    m.resetPerfStats();
+    std::vector<JSBSimAircraftState> ring(64);
+    for (int i = 0; i < frames; ++i) {
+        AllocationScope alloc;
+        m.update(DT);
+        r.update_allocations += alloc.allocations();
+
+        AllocationScope copy_alloc;
+        ring[i % ring.size()] = m.getState();
+        r.state_copy_allocations += copy_alloc.allocations();
+    }
+
+    const PerfStats stats = m.getPerfStats();
+    if (!stats.enabled) {
+        std::cerr << "bench_jsbsim: wrapper sources were built without -DJSBSIM_ENABLE_PERF_STATS, phase timings are empty"
+                  << std::endl;
+    }
+    r.update_trims_us = summarize(stats[PerfPhase::Trims]);
+    r.run_us = summarize(stats[PerfPhase::Run]);
+    r.update_state_us = summarize(stats[PerfPhase::StateExtraction]);
+    r.update_us = summarize(stats[PerfPhase::Update]);
+}
+
+// --- 1..N 架飞机 x 线程数 的吞吐量 ---
+template<class Model>
+void benchScaling(WrapperResult& r, const std::string& root, const std::string& model, int max_aircraft, ModelTemplateCache& cache) {
+    const int frames = 300;
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t aircraft = 1; aircraft <= static_cast<std::size_t>(max_aircraft); aircraft *= 2) {
+        for (unsigned threads = 1; threads <= hw; threads *= 2) {
+            FleetExecutor<Model> fleet(threads);
+            for (std::size_t i = 0; i < aircraft; ++i) spawn(fleet.emplace(), root, model, cache, i);
+
+            fleet.stepAll(DT); // 预热
+            const auto start = Clock::now();
+            for (int f = 0; f < frames; ++f) fleet.stepAll(DT);
+            const double ms = elapsedMs(start);
+
+            ScalingPoint p;
+            p.aircraft = aircraft;
+            p.threads = threads;
+            p.frame_ms = ms / frames;
+            p.steps_per_sec = ms > 0.0 ? aircraft * frames / (ms / 1000.0) : 0.0;
+            r.scaling.push_back(p);
+        }
+    }
+}
+
+template<class Model>
+bool benchWrapper(WrapperResult& r, const std::string& root, const std::string& model, int count) {
+    ModelTemplateCache cache;
+    if (!benchStartup<Model>(r, root, model, count, cache)) return false;
+    benchUpdatePhases<Model>(r, root, model, cache);
+    benchScaling<Model>(r, root, model, count, cache);
+    return true;
+}
+
+// --- 空间索引: 飞机数加倍、密度不变(每架约4平方公里), 每机邻居数保持不变 ---
+std::vector<SpatialPoint> benchSpatialIndex(std::size_t max_aircraft) {
+    const int frames = 30;
+    const double cell_m = 5000.0, radius_m = 5000.0, pair_m = 1000.0, speed_mps = 250.0;
+    const std::size_t k = 8;
+    const oe_base::batch::NedOrigin origin = oe_base::batch::NedOrigin::fromGeodetic(34.0, -118.0, 0.0);
+    std::vector<SpatialPoint> points;
+    for (std::size_t n = 256; n <= max_aircraft; n *= 2) {
+        const double half_side_m = 0.5 * std::sqrt(4.0e6 * static_cast<double>(n));
+        std::mt19937 rng(static_cast<unsigned>(n));
+        std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+        std::vector<double> lat(n), lon(n), alt(n), hdg(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            lat[i] = 34.0 + uniform(rng) * half_side_m / 111320.0;
+            lon[i] = -118.0 + uniform(rng) * half_side_m / (111320.0 * std::cos(34.0 * oe_base::angle::D2RCC));
+            alt[i] = 6000.0 + 5000.0 * uniform(rng);
+            hdg[i] = oe_base::PI * uniform(rng);
+        }
+
+        SpatialIndex index(origin, n, cell_m);
+        std::vector<SpatialIndex::Hit> hits;
+        std::vector<SpatialIndex::Pair> pairs;
+        SpatialPoint p;
+        p.aircraft = n;
+        double moved = 0.0, hit_count = 0.0;
+        for (int f = 0; f <= frames; ++f) {
+            for (std::size_t i = 0; i < n; ++i) {
+                lat[i] += speed_mps * DT * std::cos(hdg[i]) / 111320.0;
+                lon[i] += speed_mps * DT * std::sin(hdg[i]) / (111320.0 * std::cos(lat[i] * oe_base::angle::D2RCC));
+                index.update(static_cast<std::uint32_t>(i), lat[i], lon[i], alt[i]);
+            }
+            auto start = Clock::now();
+            const std::size_t m = index.commit(f * DT);
+            const double commit_us = elapsedMs(start) * 1000.0;
+            if (f == 0) continue; // 首帧为全部插入
+
+            SpatialIndex::View view = index.acquire();
+            start = Clock::now();
+            for (std::size_t i = 0; i < n; ++i) {
+                view.radius(static_cast<std::uint32_t>(i), radius_m, hits);
+                hit_count += static_cast<double>(hits.size());
+            }
+            const double radius_us = elapsedMs(start) * 1000.0;
+            start = Clock::now();
+            for (std::size_t i = 0; i < n; ++i) view.nearest(static_cast<std::uint32_t>(i), k, hits);
+            const double nearest_us = elapsedMs(start) * 1000.0;
+            start = Clock::now();
+            view.pairsWithin(pair_m, pairs);
+            const double pairs_us = elapsedMs(start) * 1000.0;
+
+            p.commit_us += commit_us / frames;
+            p.radius_us += radius_us / frames;
+            p.nearest_us += nearest_us / frames;
+            p.pairs_us += pairs_us / frames;
+            moved += static_cast<double>(m);
+        }
+        p.ns_per_aircraft = (p.commit_us + p.radius_us + p.nearest_us + p.pairs_us) * 1000.0 / static_cast<double>(n);
+        p.moved_fraction = moved / (static_cast<double>(frames) * static_cast<double>(n));
+        p.mean_hits = hit_count / (static_cast<double>(frames) * static_cast<double>(n));
+
+        // 对照: 两两比较同一帧的本地坐标
+        if (n <= 4096) {
+            SpatialIndex::View view = index.acquire();
+            std::vector<double> north(n), east(n), down(n);
+            for (std::size_t i = 0; i < n; ++i) view.position(static_cast<std::uint32_t>(i), north[i], east[i], down[i]);
+            const auto start = Clock::now();
+            std::size_t found = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                for (std::size_t j = i + 1; j < n; ++j) {
+                    const double dn = north[i] - north[j], de = east[i] - east[j], dd = down[i] - down[j];
+                    if (dn * dn + de * de + dd * dd <= pair_m * pair_m) ++found;
+                }
+            }
+            p.brute_pairs_us = elapsedMs(start) * 1000.0;
+            view.pairsWithin(pair_m, pairs);
+            if (found != pairs.size()) {
+                std::cerr << "SpatialIndex pairs mismatch: " << pairs.size() << " vs " << found << std::endl;
+            }
+        }
+        points.push_back(p);
+    }
+    return points;
+}
+
+void print(const std::vector<SpatialPoint>& points) {
+    std::cout << std::fixed << "SpatialIndex (per frame; radius 5 km and 8-nearest for every aircraft, pairs within 1 km)\n";
+    for (const SpatialPoint& p : points) {
+        std::cout << "  " << std::setw(5) << p.aircraft << " aircraft: " << std::setprecision(1)
+                  << "commit " << p.commit_us << " us, radius " << p.radius_us << " us, nearest " << p.nearest_us
+                  << " us, pairs " << p.pairs_us << " us";
+        if (p.brute_pairs_us > 0.0) std::cout << " (O(N^2) " << p.brute_pairs_us << " us)";
+        std::cout << " -> " << std::setprecision(0) << p.ns_per_aircraft << " ns/aircraft, " << std::setprecision(1)
+                  << 100.0 * p.moved_fraction << "% moved, " << p.mean_hits << " hits\n";
+    }
+    std::cout << std::setprecision(3) << std::flush;
+}
+
+void print(const WrapperResult& r) {
+    // 缓存的收益只在执行器被复用时出现: 首次使用仍要付出一次冷加载(预加载)
+    const double prewarm_per_instance = r.instances > 0 ? r.prewarm_ms / r.instances : 0.0;
+    const double amortized = prewarm_per_instance + r.cached_init_ms;
+    std::cout << std::fixed << std::setprecision(3)
+              << r.name << ": " << r.instances << " instances\n"
+              << "  cold init   : " << r.cold_init_ms << " ms/instance\n"
+              << "  prewarm     : " << r.prewarm_ms << " ms (" << prewarm_per_instance << " ms/instance, cold loads paid up front)\n"
+              << "  cached init : " << r.cached_init_ms << " ms/instance ("
+              << (r.cached_init_ms > 0.0 ? r.cold_init_ms / r.cached_init_ms : 0.0) << "x after prewarm)\n"
+              << "  with prewarm: " << amortized << " ms/instance ("
+              << (amortized > 0.0 ? r.cold_init_ms / amortized : 0.0) << "x vs cold init; first use only)\n"
+              << "  runIC       : mean " << r.run_ic_ms.mean << " ms, p99 " << r.run_ic_ms.p99 << " ms\n"
+              << "  update      : mean " << r.update_us.mean << " us (trims " << r.update_trims_us.mean
+              << ", Run " << r.run_us.mean << ", state " << r.update_state_us.mean << ")\n"
+              << "  allocations : " << r.update_allocations << " in update(), " << r.state_copy_allocations
+              << " in state copies" << (alloc_counter::installed() ? "" : " (counter not installed)") << "\n";
+    for (const ScalingPoint& p : r.scaling) {
+        std::cout << "  " << std::setw(4) << p.aircraft << " aircraft, " << std::setw(2) << p.threads << " threads: "
+                  << std::setprecision(0) << p.steps_per_sec << " steps/s" << std::setprecision(3)
+                  << " (" << p.frame_ms << " ms/frame)\n";
+    }
+    std::cout << std::flush;
+}
+
+bool writeJson(const std::string& path, const std::string& model, const std::vector<WrapperResult>& results,
+               const std::vector<SpatialPoint>& spatial) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << std::setprecision(6)
+        << "{\n  \"aircraft_model\": \"" << model << "\",\n"
+        << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n"
+        << "  \"dt\": " << DT << ",\n  \"wrappers\": [\n";
+    for (std::size_t w = 0; w < results.size(); ++w) {
+        const WrapperResult& r = results[w];
+        out << "    {\n      \"name\": \"" << r.name << "\",\n"
+            << "      \"startup\": {\"instances\": " << r.instances << ", \"cold_init_ms\": " << r.cold_init_ms
+            << ", \"prewarm_ms\": " << r.prewarm_ms << ", \"cached_init_ms\": " << r.cached_init_ms
+            << ", \"prewarm_plus_cached_init_ms\": "
+            << (r.instances > 0 ? r.prewarm_ms / r.instances : 0.0) + r.cached_init_ms << "},\n"
+            << "      \"run_ic_ms\": " << toJson(r.run_ic_ms) << ",\n"
+            << "      \"update_us\": {\n"
+            << "        \"update_trims\": " << toJson(r.update_trims_us) << ",\n"
+            << "        \"run\": " << toJson(r.run_us) << ",\n"
+            << "        \"update_state\": " << toJson(r.update_state_us) << ",\n"
+            << "        \"total\": " << toJson(r.update_us) << "\n      },\n"
+            << "      \"allocations\": {\"update\": " << r.update_allocations
+            << ", \"state_copy\": " << r.state_copy_allocations << "},\n"
+            << "      \"scaling\": [\n";
+        for (std::size_t i = 0; i < r.scaling.size(); ++i) {
+            const ScalingPoint& p = r.scaling[i];
+            out << "        {\"aircraft\": " << p.aircraft << ", \"threads\": " << p.threads
+                << ", \"frame_ms\": " << p.frame_ms << ", \"steps_per_sec\": " << p.steps_per_sec << "}"
+                << (i + 1 < r.scaling.size() ? ",\n" : "\n");
+        }
+        out << "      ]\n    }" << (w + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ],\n  \"spatial_index\": [\n";
+    for (std::size_t i = 0; i < spatial.size(); ++i) {
+        const SpatialPoint& p = spatial[i];
+        out << "    {\"aircraft\": " << p.aircraft << ", \"commit_us\": " << p.commit_us
+            << ", \"radius_us\": " << p.radius_us << ", \"nearest_us\": " << p.nearest_us
+            << ", \"pairs_us\": " << p.pairs_us << ", \"brute_pairs_us\": " << p.brute_pairs_us
+            << ", \"ns_per_aircraft\": " << p.ns_per_aircraft << ", \"moved_fraction\": " << p.moved_fraction
+            << ", \"mean_hits\": " << p.mean_hits << "}" << (i + 1 < spatial.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <jsbsim_root_dir> <aircraft_model> [count] [json_path]" << std::endl;
+        return 1;
+    }
+    const std::string root = argv[1];
+    const std::string model = argv[2];
+    const int count = argc > 3 ? std::max(1, std::atoi(argv[3])) : 50;
+    const std::string json_path = argc > 4 ? argv[4] : "bench_results.json";
+
+    std::vector<WrapperResult> results(2);
+    results[0].name = "StandaloneJSBSimModel";
+    results[1].name = "StandaloneJSBSim (V2)";
+    if (!benchWrapper<StandaloneJSBSimModel>(results[0], root, model, count)) return 1;
+    print(results[0]);
+    if (!benchWrapper<StandaloneJSBSim>(results[1], root, model, count)) return 1;
+    print(results[1]);
+
+    const std::vector<SpatialPoint> spatial = benchSpatialIndex(16384);
+    print(spatial);
+
+    if (!writeJson(json_path, model, results, spatial)) {
+        std::cerr << "Failed to write " << json_path << std::endl;
+        return 1;
+    }
+    std::cout << "Results have been saved to '" << json_path << "'." << std::endl;
+
+    // 稳态热路径不得分配内存, 作为回归检查
+    bool allocation_free = true;
+    for (const WrapperResult& r : results) {
+        if (r.update_allocations > 0 || r.state_copy_allocations > 0) {
+            std::cerr << "FAIL: " << r.name << " allocated " << r.update_allocations << " times in update() and "
+                      << r.state_copy_allocations << " times copying state" << std::endl;
+            allocation_free = false;
+        }
+    }
+    return allocation_free ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+// checkpoint_roundtrip.cpp
+// 检查点往返测试: 两架相同的飞机以同样的输入飞行一段, 其中一架保存检查点, 之后两架继续按同一串输入推进N帧,
+// 轨迹须逐位一致(保存不改变轨迹); 再把保存的一架恢复到检查点推进N帧两次, 两次的轨迹须逐位一致,
+// 且与保存后直接推进的轨迹在容差内一致(积分器与FCS组件的内部历史在恢复时重新开始), 恢复后发动机仍在运转。
+// 默认依次测试 c172x 与带作动器和滤波器的 f16。任一项失败时返回非零。
+// 编译: g++ checkpoint_roundtrip.cpp StandaloneJSBSimModel.cpp ModelTemplateCache.cpp TrimCache.cpp InputJournal.cpp -o checkpoint_roundtrip -std=c++17 -O2 -pthread -I/path/to/jsbsim/include -L/path/to/jsbsim/lib -lJSBSim
+// 用法: checkpoint_roundtrip <JSBSim根目录> [机型1,机型2,...] [帧数]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "StandaloneJSBSimModel.hpp"
+#include "InputJournal.hpp"
+#include "JSBSimCheckpoint.hpp"
+
+namespace {
+
+const double FRAME_DT = 1.0 / 60.0;
+
+// 恢复后与原轨迹的容差
+const double MAX_ALTITUDE_ERROR_M = 5.0;
+const double MAX_ANGLE_ERROR_RAD = 0.05;
+const double MAX_AIRSPEED_ERROR_KTS = 2.0;
+
+struct Trace {
+    std::vector<std::uint64_t> checksums;
+    std::vector<JSBSimAircraftState> states;
+};
+
+// 各分支施加完全相同的输入: 油门与驾驶杆随帧号变化, 覆盖FCS与发动机的瞬态
+void fly(StandaloneJSBSimModel& aircraft, int frames, Trace* trace) {
+    for (int i = 0; i < frames; ++i) {
+        aircraft.setThrottles(0.7 + 0.3 * ((i / 60) % 2));
+        aircraft.setControlStickPitch(i < frames / 2 ? -0.05 : 0.05);
+        aircraft.setControlStickRoll(0.1);
+        aircraft.update(FRAME_DT);
+        if (trace) {
+            trace->checksums.push_back(input_journal::stateChecksum(aircraft.getState()));
+            trace->states.push_back(aircraft.getState());
+        }
+    }
+}
+
+bool enginesRunning(const JSBSimAircraftState& s) {
+    if (s.num_engines == 0) return false;
+    for (const PropulsionState& p : s.propulsion) {
+        if (p.rpm <= 0.0) return false;
+    }
+    return true;
+}
+
+// 返回第一处不同的帧, 全部相同时返回 -1
+int firstDifference(const Trace& a, const Trace& b) {
+    for (std::size_t i = 0; i < a.checksums.size(); ++i) {
+        if (i >= b.checksums.size() || a.checksums[i] != b.checksums[i]) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+double angleError(double a, double b) {
+    return std::abs(std::remainder(a - b, 2.0 * oe_base::PI));
+}
+
+bool withinTolerance(const Trace& original, const Trace& restored, const std::string& model) {
+    double alt = 0.0, angle = 0.0, cas = 0.0;
+    for (std::size_t i = 0; i < original.states.size(); ++i) {
+        const JSBSimAircraftState& o = original.states[i];
+        const JSBSimAircraftState& r = restored.states[i];
+        alt = std::max(alt, std::abs(o.altitude_sl_m - r.altitude_sl_m));
+        angle = std::max({angle, angleError(o.roll_rad, r.roll_rad), angleError(o.pitch_rad, r.pitch_rad),
+                          angleError(o.yaw_rad, r.yaw_rad)});
+        cas = std::max(cas, std::abs(o.calibrated_airspeed_kts - r.calibrated_airspeed_kts));
+    }
+    std::cout << "  " << model << ": restored vs original max error: altitude " << alt << " m, attitude " << angle
+              << " rad, CAS " << cas << " kts" << std::endl;
+    return alt <= MAX_ALTITUDE_ERROR_M && angle <= MAX_ANGLE_ERROR_RAD && cas <= MAX_AIRSPEED_ERROR_KTS;
+}
+
+bool start(StandaloneJSBSimModel& aircraft, const std::string& root, const std::string& model) {
+    const bool jet = model.find("f16") != std::string::npos || model.find("f-16") != std::string::npos;
+    aircraft.setVerbose(false);
+    if (!aircraft.init(root, model)) return false;
+    aircraft.setInitialConditions(34.0, -118.0, jet ? 3000.0 : 1524.0, 90, jet ? 350.0 : 100.0);
+    aircraft.setTrimOnInit(true);
+    if (!aircraft.runInitialConditions()) return false;
+    fly(aircraft, 300, nullptr); // 先飞5秒, 离开初始条件附近
+    return true;
+}
+
+// 返回 0 通过, 1 失败, 2 无法运行
+int check(const std::string& root, const std::string& model, int frames) {
+    StandaloneJSBSimModel aircraft, reference;
+    if (!start(aircraft, root, model) || !start(reference, root, model)) return 2;
+    if (!enginesRunning(aircraft.getState())) {
+        std::cerr << "FAIL: " << model << ": engines not running before the checkpoint" << std::endl;
+        return 1;
+    }
+
+    JSBSimCheckpoint checkpoint;
+    if (!aircraft.saveCheckpoint(checkpoint)) return 2;
+
+    Trace original, untouched, replayed, replayed_again;
+    fly(aircraft, frames, &original);
+    fly(reference, frames, &untouched);
+    int diff = firstDifference(original, untouched);
+    if (diff >= 0) {
+        std::cerr << "FAIL: " << model << ": saveCheckpoint() changed the trajectory at frame " << diff << std::endl;
+        return 1;
+    }
+
+    if (!aircraft.restoreCheckpoint(checkpoint)) return 2;
+    if (!enginesRunning(aircraft.getState())) {
+        std::cerr << "FAIL: " << model << ": engines stopped by restoreCheckpoint()" << std::endl;
+        return 1;
+    }
+    fly(aircraft, frames, &replayed);
+    if (!aircraft.restoreCheckpoint(checkpoint)) return 2;
+    fly(aircraft, frames, &replayed_again);
+
+    diff = firstDifference(replayed, replayed_again);
+    if (diff >= 0) {
+        std::cerr << "FAIL: " << model << ": two restores diverge at frame " << diff << " of " << frames << std::endl;
+        return 1;
+    }
+    if (!withinTolerance(original, replayed, model)) {
+        std::cerr << "FAIL: " << model << ": restored trajectory outside tolerance" << std::endl;
+        return 1;
+    }
+    if (!enginesRunning(aircraft.getState())) {
+        std::cerr << "FAIL: " << model << ": engines stopped after the restored run" << std::endl;
+        return 1;
+    }
+
+    std::cout << "OK: " << model << ", " << frames << " frames (" << checkpoint.property_values.size() << " properties, "
+              << checkpoint.engine_running.size() << " engines)" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: checkpoint_roundtrip <jsbsim_root> [aircraft1,aircraft2,...] [frames]" << std::endl;
+        return 2;
+    }
+    const std::string root = argv[1];
+    const std::string models = argc > 2 ? argv[2] : "c172x,f16";
+    const int frames = argc > 3 ? std::max(1, std::atoi(argv[3])) : 600;
+
+    int result = 0;
+    std::istringstream list(models);
+    std::string model;
+    while (std::getline(list, model, ',')) {
+        if (model.empty()) continue;
+        result = std::max(result, check(root, model, frames));
+    }
+    return result;
+}
@@ -0,0 +1,53 @@
+// main_montecarlo.cpp
+// 编译: g++ main_montecarlo.cpp StandaloneJSBSimModel.cpp ModelTemplateCache.cpp TrimCache.cpp -o JsbSimMonteCarlo -std=c++17 -O2 -pthread -I/path/to/jsbsim/include -L/path/to/jsbsim/lib -lJSBSim
+// 用法: JsbSimMonteCarlo [运行次数] [种子] [线程数]
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include "StandaloneJSBSimModel.hpp"
+#include "MonteCarloRunner.hpp"
+
+// !!! 用户需要根据自己的环境修改这两个路径 !!!
+const std::string JSBSIM_ROOT_PATH = "/path/to/your/jsbsim/data";
+const std::string AIRCRAFT_MODEL = "c172";
+
+int main(int argc, char** argv) {
+    const std::size_t runs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+    const std::uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 42;
+    const unsigned threads = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 0;
+
+    // --- 散布设置: 与 main_jsbsim.cpp 相同的初始条件和滚转机动 ---
+    DispersionSpec spec;
+    spec.lat_deg = {34.0, 0.05};
+    spec.lon_deg = {-118.0, 0.05};
+    spec.alt_m = {1524.0, 150.0, 300.0, 4000.0};
+    spec.hdg_deg = {90.0, 10.0};
+    spec.speed_kts = {100.0, 8.0, 70.0, 140.0};
+    spec.throttle = {0.8, 0.05, 0.0, 1.0};
+
+    ControlSegment roll;
+    roll.t_start = 5.0;
+    roll.t_end = 15.0;
+    roll.roll = 0.3;
+    roll.amplitude_scale = {1.0, 0.2, 0.0, 2.0};
+    spec.schedule.push_back(roll);
+
+    spec.duration_s = 60.0;
+    spec.dt = 1.0 / 60.0;
+
+    MonteCarloRunner<StandaloneJSBSimModel> runner(JSBSIM_ROOT_PATH, AIRCRAFT_MODEL, threads);
+    if (!runner.run(spec, runs, seed, "montecarlo_results.csv")) {
+        std::cerr << "Monte Carlo run failed!" << std::endl;
+        return 1;
+    }
+
+    const MonteCarloAggregate& agg = runner.aggregate();
+    std::cout << std::fixed << std::setprecision(3)
+              << "Runs: " << agg.runs << ", failed: " << agg.failed << ", ground contacts: " << agg.ground_contacts << "\n"
+              << "Max G        : mean " << agg.max_g_load.mean() << ", std " << agg.max_g_load.stddev() << ", max " << agg.max_g_load.max << "\n"
+              << "Max alpha    : mean " << agg.max_alpha_rad.mean() * oe_base::angle::R2DCC << "deg, max " << agg.max_alpha_rad.max * oe_base::angle::R2DCC << "deg\n"
+              << "Altitude loss: mean " << agg.altitude_loss_m.mean() << "m, max " << agg.altitude_loss_m.max << "m" << std::endl;
+    std::cout << "Per-run results have been saved to 'montecarlo_results.csv'." << std::endl;
+    return 0;
+}
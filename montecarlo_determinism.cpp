@@ -0,0 +1,101 @@
+// montecarlo_determinism.cpp
+// 蒙特卡洛结果与线程数无关的测试: 同一种子分别以1个线程和N个线程运行, 两个结果文件须逐字节相同。
+// -j1 时所有运行复用同一个模型实例, -jN 时各线程的实例复用于不同的运行子集, 两者相同说明 resetToLoaded() 复位完整。
+// 两种模型各跑一遍, 另检查非正的 dt/时长被拒绝; 不一致时打印第一处不同的行并返回非零。
+// 编译: g++ montecarlo_determinism.cpp StandaloneJSBSimModel.cpp V2/StandaloneJSBSim.cpp ModelTemplateCache.cpp TrimCache.cpp -o montecarlo_determinism -std=c++17 -O2 -pthread -I/path/to/jsbsim/include -L/path/to/jsbsim/lib -lJSBSim
+// 用法: montecarlo_determinism <JSBSim根目录> [机型] [运行次数] [线程数N]
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "StandaloneJSBSimModel.hpp"
+#include "V2/StandaloneJSBSim.hpp"
+#include "MonteCarloRunner.hpp"
+
+namespace {
+
+DispersionSpec makeSpec() {
+    DispersionSpec spec;
+    spec.lat_deg = {34.0, 0.05};
+    spec.lon_deg = {-118.0, 0.05};
+    spec.alt_m = {1524.0, 150.0, 300.0, 4000.0};
+    spec.hdg_deg = {90.0, 10.0};
+    spec.speed_kts = {100.0, 8.0, 70.0, 140.0};
+    spec.throttle = {0.8, 0.05, 0.0, 1.0};
+
+    ControlSegment roll;
+    roll.t_start = 2.0;
+    roll.t_end = 6.0;
+    roll.roll = 0.3;
+    roll.amplitude_scale = {1.0, 0.2, 0.0, 2.0};
+    spec.schedule.push_back(roll);
+
+    spec.duration_s = 10.0;
+    spec.dt = 1.0 / 60.0;
+    return spec;
+}
+
+// 返回 true 表示两个文件逐行相同
+bool sameFile(const std::string& a, const std::string& b) {
+    std::ifstream fa(a), fb(b);
+    std::string la, lb;
+    for (long line = 1;; ++line) {
+        const bool ea = !std::getline(fa, la);
+        const bool eb = !std::getline(fb, lb);
+        if (ea || eb) {
+            if (ea != eb) std::cerr << "  " << (ea ? a : b) << " ends early at line " << line << std::endl;
+            return ea == eb;
+        }
+        if (la != lb) {
+            std::cerr << "  line " << line << " differs:\n    -j1: " << la << "\n    -jN: " << lb << std::endl;
+            return false;
+        }
+    }
+}
+
+template<class Model>
+bool check(const char* name, const std::string& root, const std::string& model, std::size_t runs, unsigned threads) {
+    const DispersionSpec spec = makeSpec();
+    const std::string serial = std::string("mc_determinism_") + name + "_j1.csv";
+    const std::string parallel = std::string("mc_determinism_") + name + "_jN.csv";
+
+    MonteCarloRunner<Model> one(root, model, 1);
+    MonteCarloRunner<Model> many(root, model, threads);
+    if (!one.run(spec, runs, 42, serial) || !many.run(spec, runs, 42, parallel)) {
+        std::cerr << "FAIL: " << name << " Monte Carlo run failed" << std::endl;
+        return false;
+    }
+    DispersionSpec bad = spec;
+    bad.dt = 0.0;
+    if (one.run(bad, runs, 42, serial)) {
+        std::cerr << "FAIL: " << name << " accepted dt = 0" << std::endl;
+        return false;
+    }
+    if (!sameFile(serial, parallel)) {
+        std::cerr << "FAIL: " << name << " results differ between -j1 and -j" << threads << std::endl;
+        return false;
+    }
+    std::cout << "OK: " << name << ", " << runs << " runs identical with -j1 and -j" << threads << std::endl;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: montecarlo_determinism <jsbsim_root> [aircraft] [runs] [threads]" << std::endl;
+        return 2;
+    }
+    const std::string root = argv[1];
+    const std::string model = argc > 2 ? argv[2] : "c172x";
+    const std::size_t runs = argc > 3 ? std::max(1ull, std::strtoull(argv[3], nullptr, 10)) : 32;
+    const unsigned threads = argc > 4 ? static_cast<unsigned>(std::max(2, std::atoi(argv[4])))
+                                      : std::max(2u, std::thread::hardware_concurrency());
+
+    bool ok = check<StandaloneJSBSimModel>("model", root, model, runs, threads);
+    ok = check<StandaloneJSBSim>("v2", root, model, runs, threads) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+// shared_state_bus.cpp
+// 共享内存状态总线示例与自检
+// 编译: g++ shared_state_bus.cpp SharedStateBus.cpp PointMassModel.cpp -o shared_state_bus -std=c++17 -O2 -pthread -lrt
+// 用法:
+//   shared_state_bus writer <段名> [飞机数] [秒数]   以60Hz实时推进质点模型机群并发布
+//   shared_state_bus reader <段名>                    每0.5秒打印最新帧, 写进程关闭后退出
+//   shared_state_bus selftest [读进程数] [帧数]       一个写进程 + 多个读进程, 检查读到的帧没有撕裂
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "PointMassModel.hpp"
+#include "SharedStateBus.hpp"
+
+namespace {
+
+int runWriter(const std::string& name, int aircraft, double seconds) {
+    SharedStateWriter writer;
+    if (!writer.create(name, static_cast<std::uint32_t>(aircraft))) return 1;
+
+    std::vector<PointMassModel> fleet(static_cast<std::size_t>(aircraft));
+    for (int i = 0; i < aircraft; ++i) {
+        fleet[i].init(PointMassParams::generic());
+        fleet[i].setInitialConditions(34.0, -118.0 + i * 0.01, 1500.0 + 10.0 * i, 90.0, 250.0);
+        fleet[i].runInitialConditions();
+        fleet[i].setThrottles(0.8);
+        fleet[i].setControlStickRoll(i % 2 ? 0.2 : -0.2);
+    }
+
+    const double dt = 1.0 / 60.0;
+    const auto start = std::chrono::steady_clock::now();
+    for (long long n = 1; n * dt <= seconds; ++n) {
+        // 直接写入共享内存中的帧槽, 无中间拷贝
+        JSBSimAircraftState* frame = writer.beginFrame(n * dt);
+        for (int i = 0; i < aircraft; ++i) {
+            fleet[i].update(dt);
+            frame[i] = fleet[i].getState();
+        }
+        writer.publish(static_cast<std::uint32_t>(aircraft));
+        std::this_thread::sleep_until(start + std::chrono::duration<double>(n * dt));
+    }
+    std::cout << "writer: published " << writer.framesPublished() << " frames" << std::endl;
+    return 0;
+}
+
+int runReader(const std::string& name) {
+    SharedStateReader reader;
+    while (!reader.open(name)) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    double sim_time = 0.0;
+    std::vector<std::uint32_t> ids;
+    std::vector<JSBSimAircraftState> states;
+    while (!reader.writerClosed()) {
+        if (reader.readLatest(sim_time, ids, states) && !states.empty()) {
+            const JSBSimAircraftState& s = states[0];
+            std::printf("t=%8.3f  %zu aircraft  #%u lat %.5f lon %.5f alt %.1f m roll %.2f\n", sim_time, states.size(),
+                        ids[0], s.position_ned.x(), s.position_ned.y(), s.altitude_sl_m, s.roll_rad);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+    return 0;
+}
+
+// --- 自检 ---
+// 写进程每帧把所有字段写成 (帧号, 飞机号) 的函数; 读进程零拷贝读取, stillValid() 通过的帧必须前后一致。
+double expected(std::uint64_t frame, std::uint32_t aircraft, int field) {
+    return static_cast<double>(frame) * 1000.0 + aircraft * 10.0 + field;
+}
+
+void fillState(JSBSimAircraftState& s, std::uint64_t frame, std::uint32_t aircraft) {
+    s.position_ned.set(expected(frame, aircraft, 0), expected(frame, aircraft, 1), expected(frame, aircraft, 2));
+    s.altitude_sl_m = expected(frame, aircraft, 3);
+    s.roll_rad = expected(frame, aircraft, 4);
+    s.yaw_rad = expected(frame, aircraft, 5);
+    s.num_engines = 2;
+    s.propulsion.resize(2);
+    s.propulsion[1].thrust_lbf = expected(frame, aircraft, 6);
+}
+
+bool consistent(const JSBSimAircraftState& s, std::uint64_t frame, std::uint32_t aircraft) {
+    return s.position_ned.x() == expected(frame, aircraft, 0) && s.position_ned.y() == expected(frame, aircraft, 1) &&
+           s.position_ned.z() == expected(frame, aircraft, 2) && s.altitude_sl_m == expected(frame, aircraft, 3) &&
+           s.roll_rad == expected(frame, aircraft, 4) && s.yaw_rad == expected(frame, aircraft, 5) &&
+           s.num_engines == 2 && s.propulsion[1].thrust_lbf == expected(frame, aircraft, 6);
+}
+
+int selftestReader(const std::string& name, int index) {
+    SharedStateReader reader;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!reader.open(name)) {
+        if (std::chrono::steady_clock::now() > deadline) return 3;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    long long reads = 0, retries = 0, torn = 0;
+    std::uint64_t last = 0;
+    SharedStateReader::FrameView view;
+    while (!reader.writerClosed()) {
+        if (!reader.acquire(view)) continue;
+        if (view.frame < last) ++torn; // 帧号不应倒退
+        bool ok = view.count == reader.maxAircraft();
+        for (std::uint32_t i = 0; i < view.count && ok; ++i) {
+            ok = view.ids[i] == i && consistent(view.states[i], view.frame, i);
+        }
+        if (!reader.stillValid(view)) {
+            ++retries;
+            continue;
+        }
+        if (!ok) ++torn;
+        last = view.frame;
+        ++reads;
+    }
+    std::printf("reader %d: %lld consistent frames, %lld discarded by seqlock, %lld torn\n", index, reads, retries, torn);
+    return torn == 0 && reads > 0 ? 0 : 2;
+}
+
+int runSelftest(int readers, long long frames) {
+    const std::string name = "/jsbsim_state_selftest_" + std::to_string(::getpid());
+    const std::uint32_t aircraft = 32;
+    SharedStateWriter writer;
+    if (!writer.create(name, aircraft, 4)) return 1;
+
+    std::vector<pid_t> children;
+    for (int r = 0; r < readers; ++r) {
+        const pid_t pid = ::fork();
+        if (pid == 0) {
+            const int rc = selftestReader(name, r);
+            std::fflush(stdout);
+            std::_Exit(rc);
+        }
+        if (pid < 0) {
+            std::cerr << "fork failed" << std::endl;
+            return 1;
+        }
+        children.push_back(pid);
+    }
+
+    // 等读进程映射好段再开始写, 使读写充分交错
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    for (long long n = 1; n <= frames; ++n) {
+        JSBSimAircraftState* frame = writer.beginFrame(n * 0.01);
+        for (std::uint32_t i = 0; i < aircraft; ++i) fillState(frame[i], static_cast<std::uint64_t>(n), i);
+        writer.publish(aircraft);
+    }
+    writer.close();
+
+    int failed = 0;
+    for (pid_t pid : children) {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) ++failed;
+    }
+    std::printf("selftest: %lld frames, %d readers, %s\n", frames, readers, failed ? "FAILED" : "passed");
+    return failed ? 2 : 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "writer" && argc > 2) {
+        return runWriter(argv[2], argc > 3 ? std::max(1, std::atoi(argv[3])) : 16, argc > 4 ? std::atof(argv[4]) : 60.0);
+    }
+    if (mode == "reader" && argc > 2) return runReader(argv[2]);
+    if (mode == "selftest") {
+        return runSelftest(argc > 2 ? std::max(1, std::atoi(argv[2])) : 4, argc > 3 ? std::atoll(argv[3]) : 2000000);
+    }
+    std::cerr << "Usage: " << argv[0] << " writer <name> [aircraft] [seconds] | reader <name> | selftest [readers] [frames]" << std::endl;
+    return 1;
+}
@@ -0,0 +1,189 @@
+// state_stream_loopback.cpp
+// 状态流编解码的本机UDP回环测试: 质点模型机群按固定步长尽快推进, 每帧编码后经 127.0.0.1 发送,
+// 同一进程中的接收端解码并外推, 与真值比较误差, 报告每架飞机每秒的字节数及相对原始状态的压缩比。
+// 运行中途强制一次关键帧(须到达该帧拆分出的所有数据包), 并在一半时长处重启发送端(新纪元, 序号归零),
+// 接收端须识别重启并继续跟踪; 任一检查失败时返回非零。
+// 编译: g++ state_stream_loopback.cpp StateStreamCodec.cpp PointMassModel.cpp -o state_stream_loopback -std=c++17 -O2
+// 用法: state_stream_loopback [飞机数] [仿真秒数] [丢包率0~1]
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "PointMassModel.hpp"
+#include "StateStreamCodec.hpp"
+
+namespace {
+
+struct ErrorStats {
+    double max_position_m = 0.0;
+    double max_altitude_m = 0.0;
+    double max_attitude_rad = 0.0;
+    double sum_position_m = 0.0;
+    long long samples = 0;
+};
+
+void accumulate(ErrorStats& e, const JSBSimAircraftState& truth, const JSBSimAircraftState& seen) {
+    const double dn = (seen.position_ned.x() - truth.position_ned.x()) * oe_base::angle::D2RCC * oe_base::wgs84::A;
+    const double de = oe_base::aepcdDeg(seen.position_ned.y() - truth.position_ned.y()) * oe_base::angle::D2RCC *
+                      oe_base::wgs84::A * std::cos(truth.position_ned.x() * oe_base::angle::D2RCC);
+    const double horiz = std::sqrt(dn * dn + de * de);
+    e.max_position_m = std::max(e.max_position_m, horiz);
+    e.sum_position_m += horiz;
+    e.max_altitude_m = std::max(e.max_altitude_m, std::fabs(seen.altitude_sl_m - truth.altitude_sl_m));
+    e.max_attitude_rad = std::max({e.max_attitude_rad, std::fabs(oe_base::aepcdRad(seen.roll_rad - truth.roll_rad)),
+                                   std::fabs(seen.pitch_rad - truth.pitch_rad),
+                                   std::fabs(oe_base::aepcdRad(seen.yaw_rad - truth.yaw_rad))});
+    ++e.samples;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int aircraft = argc > 1 ? std::max(1, std::atoi(argv[1])) : 50;
+    const double duration_s = argc > 2 ? std::atof(argv[2]) : 120.0;
+    const double loss = argc > 3 ? std::atof(argv[3]) : 0.0;
+    const double dt = 1.0 / 60.0;
+
+    // --- 回环套接字 ---
+    const int rx = ::socket(AF_INET, SOCK_DGRAM, 0);
+    const int tx = ::socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    const int rcvbuf = 8 << 20;
+    ::setsockopt(rx, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    if (rx < 0 || tx < 0 || ::bind(rx, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::getsockname(rx, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+        std::cerr << "Failed to set up loopback sockets" << std::endl;
+        return 1;
+    }
+
+    // --- 机群: 各机以不同相位左右压坡度、拉杆 ---
+    std::vector<PointMassModel> fleet(static_cast<std::size_t>(aircraft));
+    for (int i = 0; i < aircraft; ++i) {
+        fleet[i].init(PointMassParams::generic());
+        fleet[i].setInitialConditions(34.0 + 0.01 * (i / 10), -118.0 + 0.01 * (i % 10), 2000.0 + 50.0 * i, 10.0 * i, 220.0);
+        fleet[i].runInitialConditions();
+        fleet[i].setThrottles(0.8);
+    }
+
+    StateStreamEncoder encoder;
+    StateStreamDecoder decoder;
+    state_stream::EncoderStats total; // 重启前编码器的累计统计
+    bool ok = true;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<std::uint8_t> buffer(65536);
+    long long dropped = 0;
+    ErrorStats err;
+
+    auto send = [&](const std::vector<std::uint8_t>& packet) {
+        if (loss > 0.0 && uniform(rng) < loss) {
+            ++dropped;
+            return;
+        }
+        ::sendto(tx, packet.data(), packet.size(), 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    };
+
+    const long long frames = static_cast<long long>(duration_s / dt);
+    const long long keyframe_frame = frames / 4;
+    const long long restart_frame = frames / 2;
+    for (long long n = 1; n <= frames; ++n) {
+        const double t = n * dt;
+        if (n == restart_frame) {
+            const state_stream::EncoderStats& before = encoder.stats();
+            total.packets += before.packets;
+            total.bytes += before.bytes;
+            total.records += before.records;
+            total.keyframes += before.keyframes;
+            total.fields += before.fields;
+            encoder = StateStreamEncoder();
+        }
+        for (int i = 0; i < aircraft; ++i) {
+            // 坡度在约 ±40° 之间往复, 拉杆补偿转弯所需过载并叠加小幅俯仰机动
+            const double phase = 0.1 * i;
+            const double bank = fleet[i].getState().roll_rad;
+            const double n_turn = 1.0 / std::max(0.3, std::cos(bank));
+            fleet[i].setControlStickRoll(0.05 * std::cos(0.15 * t + phase));
+            fleet[i].setControlStickPitch((n_turn - 1.0) / (fleet[i].getParams().max_load_factor - 1.0) +
+                                          0.05 * std::sin(0.05 * t + phase));
+            fleet[i].update(dt);
+        }
+
+        if (n == keyframe_frame) encoder.requestKeyframes();
+        const std::uint64_t keyframes_before = encoder.stats().keyframes;
+        const std::uint64_t packets_before = encoder.stats().packets;
+        encoder.beginPacket(t);
+        for (int i = 0; i < aircraft; ++i) {
+            encoder.addEntity(static_cast<std::uint32_t>(i), fleet[i].getState());
+            if (encoder.full()) {
+                send(encoder.finishPacket());
+                encoder.beginPacket(t);
+            }
+        }
+        send(encoder.finishPacket());
+        if (n == keyframe_frame && encoder.stats().keyframes - keyframes_before != static_cast<std::uint64_t>(aircraft)) {
+            std::printf("FAIL: forced keyframe reached %llu of %d aircraft (%llu packets in that frame)\n",
+                        static_cast<unsigned long long>(encoder.stats().keyframes - keyframes_before), aircraft,
+                        static_cast<unsigned long long>(encoder.stats().packets - packets_before));
+            ok = false;
+        }
+
+        for (;;) {
+            const ssize_t got = ::recv(rx, buffer.data(), buffer.size(), MSG_DONTWAIT);
+            if (got <= 0) break;
+            decoder.decode(buffer.data(), static_cast<std::size_t>(got));
+        }
+        // 首个关键帧之后, 接收端每帧按外推状态与真值比较
+        JSBSimAircraftState seen;
+        for (int i = 0; i < aircraft; ++i) {
+            if (decoder.stateAt(static_cast<std::uint32_t>(i), t, seen)) accumulate(err, fleet[i].getState(), seen);
+        }
+    }
+    ::close(rx);
+    ::close(tx);
+
+    // --- 报告 ---
+    state_stream::EncoderStats s = encoder.stats();
+    s.packets += total.packets;
+    s.bytes += total.bytes;
+    s.records += total.records;
+    s.keyframes += total.keyframes;
+    s.fields += total.fields;
+    const double per_aircraft = s.bytes / duration_s / aircraft;
+    const double raw = sizeof(JSBSimAircraftState) / dt;
+    const double raw_doubles = (state_stream::EngineBase + state_stream::ENGINE_CHANNELS) * sizeof(double) / dt;
+    std::printf("%d aircraft, %.0f s at %.0f Hz, %lld packets (%lld dropped, decoder saw %llu lost)\n", aircraft,
+                duration_s, 1.0 / dt, static_cast<long long>(s.packets), dropped,
+                static_cast<unsigned long long>(decoder.packetsLost()));
+    std::printf("bytes/aircraft/s: %.1f  (raw struct %.0f -> %.1fx, raw single-engine doubles %.0f -> %.1fx)\n",
+                per_aircraft, raw, raw / per_aircraft, raw_doubles, raw_doubles / per_aircraft);
+    std::printf("records: %llu (%.1f%% of aircraft-frames), keyframes: %llu, fields/record: %.1f\n",
+                static_cast<unsigned long long>(s.records), 100.0 * s.records / (double(frames) * aircraft),
+                static_cast<unsigned long long>(s.keyframes), s.records ? double(s.fields) / s.records : 0.0);
+    std::printf("receiver error: horizontal max %.3f m (mean %.3f m), altitude max %.3f m, attitude max %.4f rad\n",
+                err.max_position_m, err.samples ? err.sum_position_m / err.samples : 0.0, err.max_altitude_m,
+                err.max_attitude_rad);
+
+    if (decoder.senderRestarts() != 1) {
+        std::printf("FAIL: decoder saw %llu sender restarts, expected 1\n",
+                    static_cast<unsigned long long>(decoder.senderRestarts()));
+        ok = false;
+    }
+    // 重启后接收端须继续跟踪: 无丢包时误差仍受门限约束
+    if (loss == 0.0 && err.max_position_m > 1.0) {
+        std::printf("FAIL: receiver lost track (horizontal error %.3f m)\n", err.max_position_m);
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+// telemetry_export.cpp
+// 离线将 .jtlm 二进制遥测文件导出为CSV
+// 编译: g++ telemetry_export.cpp TelemetryRecorder.cpp -o telemetry_export -std=c++17 -pthread
+// 用法: telemetry_export <input.jtlm> <output.csv> [列名 ...]
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "TelemetryRecorder.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <input.jtlm> <output.csv> [column ...]" << std::endl;
+        return 1;
+    }
+
+    TelemetryFileReader reader;
+    if (!reader.open(argv[1])) return 1;
+
+    // --- 选择导出的列, 缺省导出全部 ---
+    std::vector<std::size_t> selected;
+    if (argc > 3) {
+        for (int a = 3; a < argc; ++a) {
+            bool found = false;
+            for (std::size_t c = 0; c < reader.columns().size(); ++c) {
+                if (reader.columns()[c] == argv[a]) {
+                    selected.push_back(c);
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                std::cerr << "Unknown column: " << argv[a] << std::endl;
+                return 1;
+            }
+        }
+    } else {
+        for (std::size_t c = 0; c < reader.columns().size(); ++c) selected.push_back(c);
+    }
+
+    std::FILE* out = std::fopen(argv[2], "w");
+    if (!out) {
+        std::cerr << "Failed to open output file: " << argv[2] << std::endl;
+        return 1;
+    }
+
+    for (std::size_t i = 0; i < selected.size(); ++i) {
+        std::fprintf(out, "%s%s", i ? "," : "", reader.columns()[selected[i]].c_str());
+    }
+    std::fputc('\n', out);
+
+    std::size_t total = 0;
+    for (std::size_t k = 0; k < reader.numChunks(); ++k) {
+        const std::size_t rows = reader.readChunk(k);
+        for (std::size_t r = 0; r < rows; ++r) {
+            for (std::size_t i = 0; i < selected.size(); ++i) {
+                std::fprintf(out, "%s%.10g", i ? "," : "", reader.column(selected[i])[r]);
+            }
+            std::fputc('\n', out);
+        }
+        total += rows;
+    }
+    std::fclose(out);
+
+    std::cout << "Exported " << total << " rows, " << selected.size() << " columns to " << argv[2] << std::endl;
+    return 0;
+}